@@ -99,7 +99,7 @@ void CommMaliciousRepMC<T>::POpen_End(vector<typename T::clear>& values,
         throw mac_fail();
     values.clear();
     for (auto& x : S)
-        values.push_back(os[0].template get<BitVec>() + x.sum());
+        values.push_back(os[0].template get<typename T::clear>() + x.sum());
 }
 
 template<class T>
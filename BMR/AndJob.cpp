@@ -13,7 +13,7 @@ int AndJob::run()
 	printf("thread %d: run and job from %d to %d with %d gates\n",
 			pthread_self(), start, end, gates.size());
 #endif
-	__m128i prf_output[PAD_TO_8(ProgramParty::s().get_n_parties())];
+	__m128i prf_output[EVAL_PRF_BLOCKS(ProgramParty::s().get_n_parties())];
 	auto gate = gates.begin();
 	vector< GC::Secret<EvalRegister> >& S = *this->S;
 	const vector<int>& args = *this->args;
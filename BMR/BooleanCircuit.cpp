@@ -254,7 +254,7 @@ BooleanCircuit::BooleanCircuit(const char* desc_file)
 
 
 void BooleanCircuit::EvaluateByLayerLinearly(party_id_t my_id) {
-	char* prf_output = new char[PAD_TO_8(_num_parties)*16];
+	char* prf_output = new char[EVAL_PRF_BLOCKS(_num_parties)*16];
 #ifdef __PURE_SHE__
 	mpz_t temp_mpz;
 	init_temp_mpz_t(temp_mpz);
@@ -285,7 +285,7 @@ void BooleanCircuit::EvaluateByLayer(int num_threads, party_id_t my_id)
 
 void BooleanCircuit::_eval_by_layer(int i, int num_threads, party_id_t my_id)
 {
-	char* prf_output = new char[PAD_TO_8(_num_parties)*16];
+	char* prf_output = new char[EVAL_PRF_BLOCKS(_num_parties)*16];
 #ifdef __PURE_SHE__
 	mpz_t temp_mpz;
 	init_temp_mpz_t(temp_mpz);
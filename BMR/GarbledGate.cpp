@@ -40,20 +40,30 @@ void GarbledGate::compute_prfs_outputs(const Register** in_wires, int my_id,
 {
     int n_parties = CommonParty::get_n_parties();
     init_inputs(g, n_parties);
+    // one stream per (w, b, e), keys repeated for e
+    Key keys[8];
+    const Key* inputs[8];
     for(int w=0; w<=1; w++) {
         for (int b=0; b<=1; b++) {
-            const Key& key = in_wires[w]->key(my_id, b);
-            AES_KEY aes_key;
-            AES_128_Key_Expansion((unsigned char*)&key.r, &aes_key);
 #ifdef DEBUG
-            cout << "using key " << key << endl;
+            cout << "using key " << in_wires[w]->key(my_id, b) << endl;
 #endif
+            for (int e=0; e<=1; e++) {
+                keys[(w * 2 + b) * 2 + e] = in_wires[w]->key(my_id, b);
+                inputs[(w * 2 + b) * 2 + e] = &prf_inputs[e][0];
+            }
+        }
+    }
+    __m128i outputs[8 * n_parties];
+    PRF_multi(outputs, keys, inputs, 8, n_parties);
+    for(int w=0; w<=1; w++) {
+        for (int b=0; b<=1; b++) {
             for (int e=0; e<=1; e++) {
                 for (int j=1; j<= n_parties; j++) {
                     prf_output[j-1].outputs[w][b][e][0] =
-                            aes_128_encrypt(*(__m128i*)input(e, j), (octet*)aes_key.rd_key);
+                            outputs[((w * 2 + b) * 2 + e) * n_parties + j - 1];
 #ifdef __PRIME_FIELD__
-                    ((Key*)prf_outputs_index)->adjust();
+                    prf_output[j-1].outputs[w][b][e][0].adjust();
 #endif
                 }
             }
@@ -0,0 +1,64 @@
+/*
+ * PRFTest.cpp
+ *
+ */
+
+#include "prf.h"
+#include "Tools/random.h"
+#include "Tools/cpu_support.h"
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// compare against one key schedule and block at a time
+int check(PRNG& G, int n_keys, int n_blocks, bool vaes)
+{
+    vector<Key> keys(n_keys), inputs(n_keys * n_blocks);
+    G.get_octets((octet*) keys.data(), keys.size() * sizeof(Key));
+    G.get_octets((octet*) inputs.data(), inputs.size() * sizeof(Key));
+    vector<const Key*> input_pointers;
+    for (int i = 0; i < n_keys; i++)
+        input_pointers.push_back(&inputs[i * n_blocks]);
+
+    vector<Key> output(n_keys * n_blocks);
+    PRF_multi(&output[0].r, keys.data(), input_pointers.data(), n_keys,
+            n_blocks, vaes);
+
+    int errors = 0;
+    for (int i = 0; i < n_keys; i++)
+        for (int k = 0; k < n_blocks; k++)
+        {
+            Key expected;
+            PRF_chunk(keys[i], (char*) &inputs[i * n_blocks + k],
+                    (char*) &expected, 1);
+            if (expected != output[i * n_blocks + k])
+                errors++;
+        }
+    return errors;
+}
+
+int main()
+{
+    PRNG G;
+    G.ReSeed();
+    vector<bool> modes = {false};
+    if (cpu_has_vaes())
+        modes.push_back(true);
+    else
+        cout << "No VAES support" << endl;
+
+    int errors = 0;
+    for (bool vaes : modes)
+    {
+        int mode_errors = 0;
+        // partial groups of keys and partial chunks of blocks
+        for (int n_keys = 1; n_keys <= 20; n_keys++)
+            for (int n_blocks = 1; n_blocks <= 6; n_blocks++)
+                mode_errors += check(G, n_keys, n_blocks, vaes);
+        cout << (vaes ? "VAES" : "AES-NI") << ": " << mode_errors
+                << " errors" << endl;
+        errors += mode_errors;
+    }
+    return errors != 0;
+}
@@ -9,6 +9,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <stdlib.h>
 
 #include "Tools/callgrind.h"
@@ -18,6 +19,7 @@
 #include "prf.h"
 #include "BooleanCircuit.h"
 #include "Math/Setup.h"
+#include "Tools/mkpath.h"
 
 #include "Register_inline.h"
 
@@ -852,6 +854,167 @@ void ProgramParty::load_garbled_circuit()
 #endif
 }
 
+// increase when changing the format below
+const int BMR_CACHE_VERSION = 1;
+const string BMR_CACHE_MAGIC = "BMR garbled circuit cache";
+
+octetStream program_hash(const string& progname)
+{
+	string filename = "Programs/Bytecode/" + progname + "-0.bc";
+	ifstream file(filename);
+	if (not file.good())
+		throw runtime_error("cannot open " + filename);
+	string content((istreambuf_iterator<char>(file)),
+			istreambuf_iterator<char>());
+	octetStream os;
+	os.append((octet*)content.data(), content.size());
+	return os.hash();
+}
+
+void store_with_length(octetStream& os, const octetStream& x)
+{
+	os.store(x.get_length());
+	os.concat(x);
+}
+
+void get_with_length(octetStream& os, octetStream& x)
+{
+	size_t length;
+	os.get(length);
+	os.consume(x, length);
+}
+
+vector<pair<ReceivedMsgStore*, string>> ProgramParty::cache_stores()
+{
+	return {{ &wire_storage, "wires" }, { &garbled_circuits, "circuits" },
+		{ &input_masks_store, "input-masks" },
+		{ &output_masks_store, "output-masks" }};
+}
+
+string ProgramParty::cache_dir(const string& progname, const string& session)
+{
+	return string(PREP_DIR) + "BMR-Cache/" + progname + "-"
+			+ to_string(get_n_parties()) + (session.empty() ? "" : "-")
+			+ session + "-P" + to_string(P->my_num());
+}
+
+void ProgramParty::write_cache(const string& progname, const string& session)
+{
+	// identifies this garbling across parties
+	vector<octetStream> ids(P->num_players());
+	ids[P->my_num()].serialize(prng.get_doubleword());
+	P->Broadcast_Receive(ids, true);
+	octetStream id;
+	for (auto& x : ids)
+		id.concat(x);
+
+	string dir = cache_dir(progname, session);
+	remove_cache(progname, session);
+	for (auto& store : cache_stores())
+	{
+		string subdir = dir + "/" + store.second;
+		if (mkdir_p(subdir.c_str()) != 0)
+			throw runtime_error("cannot create " + subdir);
+		store.first->save(subdir);
+	}
+
+	octetStream meta;
+	meta.store(BMR_CACHE_VERSION);
+	store_with_length(meta, program_hash(progname));
+	meta.store(get_n_parties());
+	meta.store(P->my_num());
+	store_with_length(meta, id.hash());
+	meta.serialize(delta);
+	mac_key.pack(meta);
+	for (auto& wires : spdz_wires)
+	{
+		meta.store(wires.size());
+		for (auto& x : wires)
+			store_with_length(meta, x);
+	}
+
+	// written last so that incomplete caches are never loaded
+	ofstream file(dir + "/meta");
+	file << BMR_CACHE_MAGIC;
+	meta.output(file);
+	file.close();
+	if (file.fail())
+		throw runtime_error("cannot write " + dir + "/meta");
+	cerr << "Stored garbled circuit in " << dir << endl;
+}
+
+void ProgramParty::read_cache(const string& progname, const string& session)
+{
+	string dir = cache_dir(progname, session);
+	ifstream file(dir + "/meta");
+	string magic(BMR_CACHE_MAGIC.size(), 0);
+	file.read(&magic[0], magic.size());
+	size_t length = 0;
+	file.read((char*)&length, sizeof(length));
+	vector<octet> buffer(length);
+	file.read((char*)buffer.data(), length);
+	if (file.fail() or magic != BMR_CACHE_MAGIC)
+		throw runtime_error("no garbled circuit in " + dir);
+	octetStream meta;
+	meta.append(buffer.data(), length);
+
+	int version, n_parties, my_num;
+	octetStream hash, id;
+	meta.get(version);
+	if (version != BMR_CACHE_VERSION)
+		throw runtime_error("garbled circuit in " + dir
+				+ " is from a different version, please garble again");
+	get_with_length(meta, hash);
+	if (hash != program_hash(progname))
+		throw runtime_error("garbled circuit in " + dir
+				+ " is for a different version of " + progname);
+	meta.get(n_parties);
+	meta.get(my_num);
+	if (n_parties != get_n_parties() or my_num != P->my_num())
+		throw runtime_error("garbled circuit in " + dir
+				+ " is for a different setting");
+	get_with_length(meta, id);
+
+	// never evaluate a garbled circuit twice
+	remove((dir + "/meta").c_str());
+
+	vector<octetStream> ids(P->num_players(), id);
+	P->Broadcast_Receive(ids, true);
+	for (auto& x : ids)
+		if (x != id)
+			throw runtime_error("parties loaded different garbled circuits");
+
+	meta.unserialize(delta);
+	mac_key.unpack(meta);
+	for (auto& wires : spdz_wires)
+	{
+		size_t n_wires;
+		meta.get(n_wires);
+		wires.clear();
+		wires.resize(n_wires);
+		for (auto& x : wires)
+			get_with_length(meta, x);
+	}
+
+	for (auto& store : cache_stores())
+		store.first->load(dir + "/" + store.second);
+	cerr << "Loaded garbled circuit from " << dir << endl;
+}
+
+void ProgramParty::remove_cache(const string& progname, const string& session)
+{
+	string dir = cache_dir(progname, session);
+	remove((dir + "/meta").c_str());
+	for (auto& store : cache_stores())
+	{
+		string subdir = dir + "/" + store.second;
+		for (int i = 0; remove((subdir + "/" + to_string(i)).c_str()) == 0; i++)
+			;
+		rmdir(subdir.c_str());
+	}
+	rmdir(dir.c_str());
+}
+
 void ProgramParty::start_online_round()
 {
 	machine.reset_timer();
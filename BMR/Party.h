@@ -205,6 +205,12 @@ protected:
 	void store_garbled_circuit(ReceivedMsg& msg);
 	void load_garbled_circuit();
 
+	vector<pair<ReceivedMsgStore*, string>> cache_stores();
+	string cache_dir(const string& progname, const string& session);
+	void write_cache(const string& progname, const string& session);
+	void read_cache(const string& progname, const string& session);
+	void remove_cache(const string& progname, const string& session);
+
 	virtual void _check_evaluate() = 0;
 	virtual void done() = 0;
 
@@ -47,6 +47,7 @@ public:
 	~RealProgramParty();
 
 	void garble();
+	void evaluate();
 
 	void receive_keys(Register& reg);
 	void receive_all_keys(Register& reg, bool external);
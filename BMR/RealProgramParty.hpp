@@ -27,7 +27,8 @@ RealProgramParty<T>* RealProgramParty<T>::singleton = 0;
 
 template<class T>
 RealProgramParty<T>::RealProgramParty(int argc, const char** argv) :
-		garble_processor(garble_machine), dummy_proc({{}, 0})
+		garble_processor(garble_machine), prep(0), shared_proc(0),
+		dummy_proc({{}, 0}), garble_inputter(0), garble_protocol(0)
 {
 	assert(singleton == 0);
 	singleton = this;
@@ -42,9 +43,64 @@ RealProgramParty<T>::RealProgramParty(int argc, const char** argv) :
 			"-N", // Flag token.
 			"--nparties" // Flag token.
 	);
+	opt.add(
+			"1024", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Memory per message store in MB before spilling to disk (default: 1024)", // Help description.
+			"-M", // Flag token.
+			"--buffer-memory" // Flag token.
+	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			0, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Compress garbled circuits spilled to disk (needs USE_LZ4)", // Help description.
+			"-Z", // Flag token.
+			"--compress" // Flag token.
+	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			0, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Only garble and store the garbled circuit in Player-Data/BMR-Cache", // Help description.
+			"-G", // Flag token.
+			"--garble-only" // Flag token.
+	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			0, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Only evaluate a garbled circuit stored with -G", // Help description.
+			"-E", // Flag token.
+			"--evaluate-only" // Flag token.
+	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Name to distinguish several stored garbled circuits of the same program", // Help description.
+			"-S", // Flag token.
+			"--session" // Flag token.
+	);
 	opt.parse(argc, argv);
 	int nparties;
 	opt.get("-N")->getInt(nparties);
+	long long buffer_memory;
+	opt.get("-M")->getLongLong(buffer_memory);
+	ReceivedMsgStore::memory_budget = buffer_memory << 20;
+	ReceivedMsgStore::compress = opt.isSet("-Z");
+	bool garble_only = opt.isSet("-G");
+	bool evaluate_only = opt.isSet("-E");
+	string session;
+	opt.get("-S")->getString(session);
+	if (garble_only and evaluate_only)
+		throw runtime_error("cannot use -G and -E together");
 	this->check(nparties);
 
 	NetworkOptions network_opts(opt, argc, argv);
@@ -79,6 +135,20 @@ RealProgramParty<T>::RealProgramParty(int argc, const char** argv) :
 	cerr << "delta: " << delta << endl;
 #endif
 
+	this->processor.open_input_file(N.my_num(), 0);
+
+	if (evaluate_only)
+	{
+		this->read_cache(online_opts.progname, session);
+		MC = new typename T::MAC_Check(mac_key);
+		evaluate();
+		MC->Check(*P);
+		this->remove_cache(online_opts.progname, session);
+		if (server)
+			delete server;
+		return;
+	}
+
 	string prep_dir = get_prep_dir(nparties, 128, 128);
 	usage = DataPositions(N.num_players());
 	if (online_opts.live_prep)
@@ -98,7 +168,6 @@ RealProgramParty<T>::RealProgramParty(int argc, const char** argv) :
 	MC = new typename T::MAC_Check(mac_key);
 
 	garble_processor.reset(program);
-	this->processor.open_input_file(N.my_num(), 0);
 
 	shared_proc = new SubProcessor<T>(dummy_proc, *MC, *prep, *P);
 
@@ -122,19 +191,21 @@ RealProgramParty<T>::RealProgramParty(int argc, const char** argv) :
 	{
 		next = GC::TIME_BREAK;
 		garble();
-		try
-		{
-			this->online_timer.start();
-			this->start_online_round();
-			this->online_timer.stop();
-		}
-		catch (needs_cleaning& e)
+		if (garble_only)
 		{
+			if (next != GC::DONE_BREAK)
+				throw runtime_error("program needs evaluation before "
+						"garbling is complete, cannot only garble");
+			MC->Check(*P);
+			this->write_cache(online_opts.progname, session);
+			break;
 		}
+		evaluate();
 	}
 	while (next != GC::DONE_BREAK);
 
-	MC->Check(*P);
+	if (not garble_only)
+		MC->Check(*P);
 
 	if (server)
 		delete server;
@@ -183,6 +254,20 @@ void RealProgramParty<T>::garble()
 	}
 }
 
+template<class T>
+void RealProgramParty<T>::evaluate()
+{
+	try
+	{
+		this->online_timer.start();
+		this->start_online_round();
+		this->online_timer.stop();
+	}
+	catch (needs_cleaning& e)
+	{
+	}
+}
+
 template<class T>
 RealProgramParty<T>::~RealProgramParty()
 {
@@ -213,7 +213,7 @@ void EvalRegister::op(const ProgramRegister& left, const ProgramRegister& right,
 	GarbledGate gate(party.get_n_parties());
 	party.next_gate(gate);
 	gate.unserialize(party.garbled_circuit, party.get_n_parties());
-	party.prf_output.resize(PAD_TO_8(party.get_n_parties()) * sizeof(__m128i));
+	party.prf_output.resize(EVAL_PRF_BLOCKS(party.get_n_parties()) * sizeof(__m128i));
 	Register::eval(left, right, gate, party._id, party.prf_output.data(),
 			get_id(), left.get_id(), right.get_id());
 }
@@ -250,36 +250,33 @@ void Register::eval(const Register& left, const Register& right, GarbledGate& ga
     unsigned g = gate.id;
 #endif
 
-    Key k;
-    for(party_id_t i=1; i<=n_parties; i++) {
-#ifdef DEBUG
-                                std::cout << "using key: " << left.external_key(i) << endl;
-#endif
-        PRF_chunk(left.external_key(i), gate.input(ext_l, 1), prf_output, PAD_TO_8(n_parties));
-        for(party_id_t j=1; j<=n_parties; j++) {
-            k = *(Key*)(prf_output+16*(j-1));
-#ifdef __PRIME_FIELD__
-            k.adjust();
-#endif
-#ifdef DEBUG
-                        printf("Fk^%d_{%u,%d}(%d,%u,%d) = ",i, w_l, sig_l,ext_l,g,j);
-                        std::cout << k << std::endl;
-#endif
-            garbled_entry[j-1] -= k;
-        }
+    // all 2n keys in one go, left then right
+    vector<Key> keys(2 * n_parties);
+    vector<const Key*> inputs(2 * n_parties);
+    for(size_t i=0; i<2*n_parties; i++) {
+        bool is_left = i < n_parties;
+        keys[i] = (is_left ? left : right).external_key(i % n_parties + 1);
+        inputs[i] = (Key*)gate.input(is_left ? ext_l : ext_r, 1);
+    }
+    PRF_multi((__m128i*)prf_output, keys.data(), inputs.data(), 2 * n_parties,
+            n_parties);
 
+    Key k;
+    for(party_id_t i=1; i<=2*n_parties; i++) {
 #ifdef DEBUG
-                                    std::cout << "using key: " << right.external_key(i) << endl;
+        std::cout << "using key: " << keys[i-1] << endl;
 #endif
-        PRF_chunk(right.external_key(i), gate.input(ext_r, 1) , prf_output, PAD_TO_8(n_parties));
         for(party_id_t j=1; j<=n_parties; j++) {
-            k = *(Key*)(prf_output+16*(j-1));
+            k = *(Key*)(prf_output+16*((i-1)*n_parties+j-1));
 #ifdef __PRIME_FIELD__
             k.adjust();
 #endif
 #ifdef DEBUG
-            printf("Fk^%d_{%u,%d}(%d,%u,%d) = ",i, w_r, sig_r,ext_r,g,j);
-                        std::cout << k << std::endl;
+            if (i <= n_parties)
+                printf("Fk^%d_{%u,%d}(%d,%u,%d) = ",i, w_l, sig_l,ext_l,g,j);
+            else
+                printf("Fk^%d_{%u,%d}(%d,%u,%d) = ",i-n_parties, w_r, sig_r,ext_r,g,j);
+            std::cout << k << std::endl;
 #endif
             garbled_entry[j-1] -= k;
         }
@@ -26,6 +26,8 @@ using namespace std;
 
 //#define PAD_TO_8(n) (n+8-n%8)
 #define PAD_TO_8(n) (n)
+// blocks needed by Register::eval, 2n keys with n blocks each
+#define EVAL_PRF_BLOCKS(n) (2 * (n) * (n))
 
 #ifdef N_PARTIES
 #define MAX_N_PARTIES N_PARTIES
@@ -0,0 +1,163 @@
+/*
+ * prf.cpp
+ *
+ */
+
+#include "prf.h"
+#include "Tools/cpu_support.h"
+
+#include <immintrin.h>
+#include <algorithm>
+
+#define VAES "avx512f,vaes"
+
+// round keys for eight keys, key-minor to load four of them at once
+typedef __m128i MultiSchedule[11][8];
+
+#ifdef __AES__
+
+// aeskeygenassist is microcoded on many CPUs, so the substitution is
+// done with aesenclast on the rotated last word instead
+inline __m128i expand_step(__m128i key, __m128i rcon)
+{
+	const __m128i rotate = _mm_set1_epi32(0x0c0f0e0d);
+	__m128i tmp = _mm_aesenclast_si128(_mm_shuffle_epi8(key, rotate), rcon);
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	return _mm_xor_si128(key, tmp);
+}
+
+// independent schedules interleaved, unused slots are never selected
+// but still loaded by VAES, so the caller zero-initializes them
+void expand_keys(MultiSchedule& rd_keys, const Key* keys, int n_keys)
+{
+	const int rcons[] = { 1, 2, 4, 8, 16, 32, 64, 128, 27, 54 };
+	for (int i = 0; i < 8; i++)
+		rd_keys[0][i] = keys[std::min(i, n_keys - 1)].r;
+	for (int r = 1; r < 11; r++)
+	{
+		__m128i rcon = _mm_set1_epi32(rcons[r - 1]);
+		for (int i = 0; i < n_keys; i++)
+			rd_keys[r][i] = expand_step(rd_keys[r - 1][i], rcon);
+	}
+}
+
+#ifndef __clang__
+__attribute__((optimize("unroll-loops")))
+#endif
+void encrypt_chunk(__m128i* blocks, const MultiSchedule& rd_keys,
+		const int* key_index)
+{
+	__m128i tmp[8];
+	for (int l = 0; l < 8; l++)
+		tmp[l] = _mm_xor_si128(blocks[l], rd_keys[0][key_index[l]]);
+	for (int r = 1; r < 10; r++)
+		for (int l = 0; l < 8; l++)
+			tmp[l] = _mm_aesenc_si128(tmp[l], rd_keys[r][key_index[l]]);
+	for (int l = 0; l < 8; l++)
+		blocks[l] = _mm_aesenclast_si128(tmp[l], rd_keys[10][key_index[l]]);
+}
+
+// four 128-bit lanes per register, round keys picked by permutation
+__attribute__((target(VAES)))
+void encrypt_chunk_vaes(__m128i* blocks, const MultiSchedule& rd_keys,
+		const int* key_index)
+{
+	__m512i tmp[4], index[4];
+	for (int z = 0; z < 4; z++)
+	{
+		const int* q = key_index + 4 * z;
+		index[z] = _mm512_set_epi64(2 * q[3] + 1, 2 * q[3], 2 * q[2] + 1,
+				2 * q[2], 2 * q[1] + 1, 2 * q[1], 2 * q[0] + 1, 2 * q[0]);
+		tmp[z] = _mm512_loadu_si512(blocks + 4 * z);
+	}
+	for (int r = 0; r < 11; r++)
+	{
+		__m512i low = _mm512_loadu_si512(&rd_keys[r][0]);
+		__m512i high = _mm512_loadu_si512(&rd_keys[r][4]);
+		for (int z = 0; z < 4; z++)
+		{
+			__m512i key = _mm512_permutex2var_epi64(low, index[z], high);
+			if (r == 0)
+				tmp[z] = _mm512_xor_si512(tmp[z], key);
+			else if (r < 10)
+				tmp[z] = _mm512_aesenc_epi128(tmp[z], key);
+			else
+				tmp[z] = _mm512_aesenclast_epi128(tmp[z], key);
+		}
+	}
+	for (int z = 0; z < 4; z++)
+		_mm512_storeu_si512(blocks + 4 * z, tmp[z]);
+}
+
+#endif
+
+void PRF_multi(__m128i* out, const Key* keys, const Key* const* inputs,
+		int n_keys, int n_blocks)
+{
+	PRF_multi(out, keys, inputs, n_keys, n_blocks, true);
+}
+
+void PRF_multi(__m128i* out, const Key* keys, const Key* const* inputs,
+		int n_keys, int n_blocks, bool vaes)
+{
+#ifdef __AES__
+	if (cpu_has_aes())
+	{
+		static bool has_vaes = cpu_has_vaes();
+		vaes &= has_vaes;
+		MultiSchedule rd_keys = {};
+		for (int i = 0; i < n_keys; i += 8)
+		{
+			int n_group = std::min(8, n_keys - i);
+			expand_keys(rd_keys, keys + i, n_group);
+			int total = n_group * n_blocks;
+			int key = 0, k = 0;
+			for (int start = 0; start < total;)
+			{
+				int width = (vaes and total - start > 8) ? 16 : 8;
+				int n = std::min(width, total - start);
+				__m128i blocks[16];
+				int key_index[16];
+				for (int l = 0; l < n; l++)
+				{
+					key_index[l] = key;
+					blocks[l] = inputs[i + key][k].r;
+					if (++k == n_blocks)
+					{
+						k = 0;
+						key++;
+					}
+				}
+				// pad by repeating the last block
+				for (int l = n; l < width; l++)
+				{
+					key_index[l] = key_index[n - 1];
+					blocks[l] = blocks[n - 1];
+				}
+				if (width == 16)
+					encrypt_chunk_vaes(blocks, rd_keys, key_index);
+				else
+					encrypt_chunk(blocks, rd_keys, key_index);
+				std::copy(blocks, blocks + n, out + i * n_blocks + start);
+				start += n;
+			}
+		}
+	}
+	else
+#endif
+	{
+		for (int i = 0; i < n_keys; i++)
+		{
+			AES_KEY aes_key;
+			AES_128_Key_Expansion((unsigned char*)&keys[i].r, &aes_key);
+			for (int k = 0; k < n_blocks; k++)
+			{
+				__m128i block = inputs[i][k].r;
+				ecb_aes_128_encrypt<1>(&out[i * n_blocks + k], &block,
+						(octet*)aes_key.rd_key);
+			}
+		}
+	}
+}
@@ -32,4 +32,16 @@ inline void PRF_chunk(const Key& key, char* input, char* output, int number)
 	}
 }
 
+/*
+ * Encrypts n_blocks consecutive blocks under each of n_keys keys:
+ * out[i * n_blocks + k] = AES_{keys[i]}(inputs[i][k]).
+ * Keys are expanded eight at a time and blocks under different keys
+ * are interleaved in the AES pipeline, using VAES if available.
+ */
+void PRF_multi(__m128i* out, const Key* keys, const Key* const* inputs,
+		int n_keys, int n_blocks);
+// VAES only if requested and available
+void PRF_multi(__m128i* out, const Key* keys, const Key* const* inputs,
+		int n_keys, int n_blocks, bool vaes);
+
 #endif /* PROTOCOL_INC_PRF_H_ */
@@ -237,15 +237,13 @@ class sbits(bits):
             inst.ldbits(self, self.n, value)
         elif self.n <= 64:
             self.load_other(regint(value))
-        elif self.n <= 128:
+        else:
             lower = sbits.get_type(64)(value % 2**64)
             upper = sbits.get_type(self.n - 64)(value >> 64)
             self.mov(self, lower + (upper << 64))
-        else:
-            raise NotImplementedError('more than 128 bits wanted')
     @read_mem_value
     def __add__(self, other):
-        if isinstance(other, int):
+        if isinstance(other, (int, long)):
             return self.xor_int(other)
         else:
             if not isinstance(other, sbits):
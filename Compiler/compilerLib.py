@@ -27,6 +27,8 @@ def run(args, options, param=-1, merge_opens=True, emulate=True, \
     if options.binary:
         VARS['sint'] = GC.types.sbitint.get_type(int(options.binary))
         VARS['sfix'] = GC.types.sbitfix
+    if options.register_width:
+        GC.types.sbits.max_length = int(options.register_width)
     comparison.set_variant(options)
     
     print 'Compiling file', prog.infile
@@ -1439,6 +1439,31 @@ class dotprods(base.VarArgsInstruction, base.DataInstruction):
             for reg in self.args[i + 2:i + self.args[i]]:
                 yield reg
 
+@base.gf2n
+class matmuls(base.DataInstruction):
+    """ Secret matrix multiplication $s_i = s_j \cdot s_k$ of row-major
+    matrices with dimensions given by the last three arguments. """
+    __slots__ = []
+    code = base.opcodes['MATMULS']
+    arg_format = ['sw','s','s','int','int','int']
+    data_type = 'triple'
+    is_vec = lambda self: True
+
+    def __init__(self, res, A, B, m, n, k):
+        assert res.size == m * k
+        assert A.size == m * n
+        assert B.size == n * k
+        base.Instruction.__init__(self, res, A, B, m, n, k)
+
+    def get_repeat(self):
+        return self.args[3] * self.args[4] * self.args[5]
+
+    def get_def(self):
+        return self.args[0].get_all()
+
+    def get_used(self):
+        return self.args[1].get_all() + self.args[2].get_all()
+
 ###
 ### CISC-style instructions
 ###
@@ -89,6 +89,7 @@ opcodes = dict(
     MULS = 0xA6,
     MULRS = 0xA7,
     DOTPRODS = 0xA8,
+    MATMULS = 0xAA,
     # Data access
     TRIPLE = 0x50,
     BIT = 0x51,
@@ -979,9 +979,12 @@ class _secret(_register):
         res = cls(size=size)
         n_rows = len(A) / n
         n_cols = len(B) / n
-        dotprods(*sum(([res[j], [A[j / n_cols * n + k] for k in range(n)],
-                        [B[k * n_cols + j % n_cols] for k in range(n)]]
-                       for j in range(size)), []))
+        if isinstance(A, cls) and isinstance(B, cls):
+            matmuls(res, A, B, n_rows, n, n_cols)
+        else:
+            dotprods(*sum(([res[j], [A[j / n_cols * n + k] for k in range(n)],
+                            [B[k * n_cols + j % n_cols] for k in range(n)]]
+                           for j in range(size)), []))
         return res
 
     def __init__(self, reg_type, val=None, size=None):
@@ -79,7 +79,7 @@ void mul(Ciphertext& ans,const Ciphertext& c0,const Ciphertext& c1,
   add(d1,d1,t);
 
   ans.set(d0, d1, check_pk_id(c0.pk_id, c1.pk_id));
-  ans.Scale(pk.p());
+  ans.Scale(pk.p(), true);
 }
 
 
@@ -54,7 +54,8 @@ class Ciphertext
   friend istream& operator>>(istream& s,Ciphertext& c);
 
   // Scale down an element from level 1 to level 0, if at level 0 do nothing
-  void Scale(const bigint& p)    { cc0.Scale(p); cc1.Scale(p); }
+  void Scale(const bigint& p, bool key_switched = false)
+    { cc0.Scale(p, key_switched); cc1.Scale(p, key_switched); }
 
   // Throws error if ans,c0,c1 etc have different params settings
   //   - Thus programmer needs to ensure this rather than this being done
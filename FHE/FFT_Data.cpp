@@ -18,7 +18,10 @@ void FFT_Data::assign(const FFT_Data& FFTD)
   b=FFTD.b;
 
   iphi=FFTD.iphi;
-
+  ntt=FFTD.ntt;
+  crt=FFTD.crt;
+  crt_inv=FFTD.crt_inv;
+  crt_inv_shoup=FFTD.crt_inv_shoup;
 }
 
 
@@ -43,10 +46,19 @@ void FFT_Data::init(const Ring& Rg,const Zp_Data& PrD)
       nb=1<<(nb-1);
       if (nb==Rg.m())
         { //cout << Rg.m() << " " << PrD.pr << endl;
-          root[0]=Find_Primitive_Root_2power(Rg.m(),PrD);
-          Inv(root[1],root[0],PrD);
-          to_modp(iphi,Rg.phi_m(),PrD);
-          Inv(iphi,iphi,PrD);
+          init_ntt();
+          if (rns())
+            { // no root modulo a product of primes
+              assignZero(root[0],PrD);
+              assignZero(root[1],PrD);
+              assignZero(iphi,PrD);
+            }
+          else
+            { root[0]=Find_Primitive_Root_2power(Rg.m(),PrD);
+              Inv(root[1],root[0],PrD);
+              to_modp(iphi,Rg.phi_m(),PrD);
+              Inv(iphi,iphi,PrD);
+            }
         }
     }
   else 
@@ -143,7 +155,9 @@ istream& operator>>(istream& s,FFT_Data& FFTD)
   s >> FFTD.twop;
 
   if (FFTD.twop==0)
-    { s >> ans; to_modp(FFTD.iphi,ans,FFTD.prData); }
+    { s >> ans; to_modp(FFTD.iphi,ans,FFTD.prData);
+      FFTD.init_ntt();
+    }
   else if (FFTD.twop>0)
     { FFTD.two_root.resize(2);
 
@@ -168,6 +182,44 @@ istream& operator>>(istream& s,FFT_Data& FFTD)
 }
 
 
+void FFT_Data::init_ntt()
+{
+  ntt.clear();
+  crt.clear();
+  crt_inv.clear();
+  crt_inv_shoup.clear();
+  vector<mp_limb_t> primes;
+  if (twop!=0 or not NTT_Data::factorize(primes,prData.pr,R.m()))
+    { return; }
+
+  ntt.resize(primes.size());
+  for (size_t i=0; i<primes.size(); i++)
+    { ntt[i].init(R.phi_m(),primes[i]);
+      crt.push_back(prData.pr/primes[i]);
+      crt_inv.push_back(ntt[i].power(ntt[i].reduce(crt[i]),primes[i]-2));
+      crt_inv_shoup.push_back(ntt[i].shoup(crt_inv[i]));
+    }
+}
+
+
+void FFT_Data::to_rns(mp_limb_t* x,const bigint& a,int stride) const
+{
+  for (size_t i=0; i<ntt.size(); i++)
+    { x[i*stride]=ntt[i].reduce(a); }
+}
+
+
+void FFT_Data::from_rns(bigint& ans,const mp_limb_t* x,int stride) const
+{
+  ans=0;
+  for (size_t i=0; i<ntt.size(); i++)
+    { mpz_addmul_ui(ans.get_mpz_t(),crt[i].get_mpz_t(),
+          ntt[i].mul(x[i*stride],crt_inv[i],crt_inv_shoup[i]));
+    }
+  mpz_mod(ans.get_mpz_t(),ans.get_mpz_t(),prData.pr.get_mpz_t());
+}
+
+
 void FFT_Data::pack(octetStream& o) const
 {
   R.pack(o);
@@ -5,6 +5,7 @@
 #include "Math/Zp_Data.h"
 #include "Math/gfp.h"
 #include "FHE/Ring.h"
+#include "FHE/NTT.h"
 
 /* Class for holding modular arithmetic data wrt the ring 
  *
@@ -33,6 +34,16 @@ class FFT_Data
   modp iphi;    // 1/phi_m mod pr
   vector< vector<modp> > powers,powers_i;
 
+  // Word-sized primes when m is a power of 2 and pr is such a prime
+  // or a product of them (see NTT.h)
+  vector<NTT_Data> ntt;
+
+  // For the CRT: pr divided by each prime and its inverse modulo the prime
+  vector<bigint> crt;
+  vector<mp_limb_t> crt_inv, crt_inv_shoup;
+
+  void init_ntt();
+
   public:
   typedef gfp T;
   typedef bigint S;
@@ -70,6 +81,14 @@ class FFT_Data
   modp get_root(int i) const     { return root[i];    }
   modp get_iphi() const          { return iphi;       }
 
+  // Whether Ring_Element uses residues modulo the primes in get_ntt()
+  bool rns() const               { return not ntt.empty(); }
+  const vector<NTT_Data>& get_ntt() const { return ntt; }
+
+  // Residues of a at x[0], x[stride], ... and back
+  void to_rns(mp_limb_t* x,const bigint& a,int stride) const;
+  void from_rns(bigint& ans,const mp_limb_t* x,int stride) const;
+
   const Ring& get_R() const      { return R; }
 
   bool operator==(const FFT_Data& other) const { return not (*this != other); }
@@ -33,29 +33,4 @@ public:
     void get(T& x) const { x = v[i]; i++; }
 };
 
-class ConversionIterator : public Generator<bigint>
-{
-    const vector<modp>& v;
-    const Zp_Data& ZpD;
-    mutable size_t i;
-
-public:
-    ConversionIterator(const vector<modp>& v, const Zp_Data& ZpD) : v(v), ZpD(ZpD), i(0) {}
-    Generator<bigint>* clone() const { return new ConversionIterator(*this); }
-    void get(bigint& x) const { to_bigint(x, v[i], ZpD); i++; }
-};
-
-class WriteConversionIterator : public Generator<bigint>
-{
-    vector<modp>& v;
-    const Zp_Data& ZpD;
-    mutable size_t i;
-    mutable bigint tmp;
-
-public:
-    WriteConversionIterator(vector<modp>& v, const Zp_Data& ZpD) : v(v), ZpD(ZpD), i(0) {}
-    Generator<bigint>* clone() const { return new WriteConversionIterator(*this); }
-    void get(bigint& x) const { tmp = x; v[i].convert_destroy(tmp, ZpD); i++; }
-};
-
 #endif /* FHE_GENERATOR_H_ */
@@ -8,6 +8,7 @@
 #include "FHE/P2Data.h"
 #include "FHE/QGroup.h"
 #include "FHE/NoiseBounds.h"
+#include "FHE/NTT.h"
 
 #include "Tools/mkpath.h"
 
@@ -68,6 +69,15 @@ bool same_word_length(int l1, int l2)
   return l1 / 64 == l2 / 64;
 }
 
+/* Moduli for power-of-two m are products of NTT primes, so p1 is not
+ * 1 modulo p. Scaling fresh ciphertexts then multiplies the noise by
+ * up to p/2 (see Rq_Element::Scale), which p1 has to make up for.
+ */
+int extra_p1_bits(int m, const bigint& p)
+{
+  return NTT_Data::power_of_two(m) ? numBits(p) : 0;
+}
+
 template <>
 int generate_semi_setup(int plaintext_length, int sec,
     FHE_Params& params, FFT_Data& FTD, bool round_up)
@@ -86,7 +96,8 @@ int generate_semi_setup(int plaintext_length, int sec,
         {
           p0 *= 2;
         }
-      if (phi_N(m) < nb.min_phi_m(numBits(p0 * (params.n_mults() > 0 ? p1 : 1))))
+      int extra = params.n_mults() > 0 ? extra_p1_bits(m, p) : 0;
+      if (phi_N(m) < nb.min_phi_m(numBits(p0 * (params.n_mults() > 0 ? p1 : 1)) + extra))
         {
           m *= 2;
           generate_prime(p, lgp, m);
@@ -94,7 +105,7 @@ int generate_semi_setup(int plaintext_length, int sec,
       else
         {
           lgp0 = numBits(p0) + 1;
-          lgp1 = numBits(p1) + 1;
+          lgp1 = numBits(p1) + 1 + extra;
           break;
         }
     }
@@ -233,10 +244,15 @@ int SPDZ_Data_Setup_Char_p_Sub(Ring& R, bigint& pr0, bigint& pr1, int n,
   else if (sec == -1)
     throw runtime_error("no precomputed parameters available");
 
+  if (sec == -1)
+    lg2p1 += extra_p1_bits(m, p);
+
   while (sec != -1)
     {
       double phi_m_bound =
               NoiseBounds(p, phi_N(m), n, sec, slack).optimize(lg2p0, lg2p1);
+      lg2p1 += extra_p1_bits(m, p);
+      phi_m_bound = max(phi_m_bound, NoiseBounds::min_phi_m(lg2p0 + lg2p1));
       cout << "Trying primes of length " << lg2p0 << " and " << lg2p1 << endl;
       if (phi_N(m) < phi_m_bound)
         {
@@ -270,6 +286,15 @@ void generate_modulus(bigint& pr, const int m, const bigint p, const int lg2pr,
 
   if (lg2pr==0) { throw invalid_params(); }
 
+  if (NTT_Data::power_of_two(m))
+    { NTT_Data::generate_modulus(pr, m, lg2pr, pr0 == 0 ? p : p * pr0);
+      cout << "\t pr" << i << " = " << pr << "  :   " << numBits(pr) <<  endl;
+      cout << "\t\tProduct of " << DIV_CEIL(lg2pr, NTT_Data::PRIME_BITS)
+          << " primes for the NTT" << endl;
+      cout << "Minimal MAX_MOD_SZ = " << int(ceil(1. * lg2pr / 64)) << endl;
+      return;
+    }
+
   bigint step=m;
   bigint twop=1<<(numBits(m)+1);
   bigint gc=gcd(step,twop);
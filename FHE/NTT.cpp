@@ -0,0 +1,275 @@
+/*
+ * NTT.cpp
+ *
+ */
+
+#include "NTT.h"
+#include "Exceptions/Exceptions.h"
+
+#include <assert.h>
+
+inline mp_limb_t mul_mod(mp_limb_t a, mp_limb_t b, mp_limb_t q)
+{
+  return (__uint128_t) a * b % q;
+}
+
+// deterministic Miller-Rabin for 64-bit numbers
+bool is_prime(mp_limb_t x)
+{
+  const int bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  for (int p : bases)
+    if (x % p == 0)
+      return x == mp_limb_t(p);
+  if (x < 2)
+    return false;
+
+  mp_limb_t d = x - 1;
+  int s = 0;
+  while (d % 2 == 0)
+    {
+      d /= 2;
+      s++;
+    }
+
+  for (int a : bases)
+    {
+      mp_limb_t y = 1, base = a;
+      for (mp_limb_t e = d; e; e >>= 1)
+        {
+          if (e & 1)
+            y = mul_mod(y, base, x);
+          base = mul_mod(base, base, x);
+        }
+      if (y == 1 or y == x - 1)
+        continue;
+      int i;
+      for (i = 1; i < s; i++)
+        {
+          y = mul_mod(y, y, x);
+          if (y == x - 1)
+            break;
+        }
+      if (i == s)
+        return false;
+    }
+  return true;
+}
+
+// the largest primes of n_bits bits that are 1 modulo m in descending order
+void ntt_primes(vector<mp_limb_t>& res, int m, int n_bits)
+{
+  res.clear();
+  mp_limb_t top = mp_limb_t(1) << n_bits, bottom = top / 2;
+  for (mp_limb_t x = (top - 1) / m * m + 1;
+      x > bottom and res.size() < size_t(NTT_Data::MAX_PRIMES); x -= m)
+    if (is_prime(x))
+      res.push_back(x);
+}
+
+void NTT_Data::generate_modulus(bigint& q, int m, int lg2q,
+    const bigint& avoid)
+{
+  if (not power_of_two(m) or lg2q < 1)
+    throw invalid_params();
+
+  // as many primes as necessary, all of similar length
+  int k = DIV_CEIL(lg2q, PRIME_BITS);
+  int bits = lg2q / k;
+  q = 1;
+  vector<mp_limb_t> primes;
+  for (int i = 0; i < 2; i++)
+    {
+      int n_bits = bits + 1 - i;
+      int n_primes = i ? k - lg2q % k : lg2q % k;
+      if (n_primes == 0)
+        continue;
+      ntt_primes(primes, m, n_bits);
+      for (auto prime : primes)
+        if (n_primes > 0
+            and not mpz_divisible_ui_p(avoid.get_mpz_t(), prime))
+          {
+            q *= prime;
+            n_primes--;
+          }
+      if (n_primes > 0)
+        throw runtime_error(
+            "not enough NTT primes of length " + to_string(n_bits));
+    }
+
+  if (numBits(q) != lg2q)
+    throw runtime_error("product of NTT primes too short");
+}
+
+bool NTT_Data::factorize(vector<mp_limb_t>& primes, const bigint& q, int m)
+{
+  primes.clear();
+  if (not power_of_two(m) or mpz_fdiv_ui(q.get_mpz_t(), m) != 1)
+    return false;
+
+  int lg2q = numBits(q);
+  if (lg2q <= MAX_BITS and is_prime(q.get_ui()))
+    {
+      primes.push_back(q.get_ui());
+      return true;
+    }
+
+  // same lengths as in generate_modulus()
+  int k = DIV_CEIL(lg2q, PRIME_BITS);
+  int bits = lg2q / k;
+  bigint rest = q;
+  vector<mp_limb_t> candidates;
+  for (int n_bits = bits + 1; n_bits >= bits and rest != 1; n_bits--)
+    {
+      ntt_primes(candidates, m, n_bits);
+      for (auto prime : candidates)
+        if (mpz_divisible_ui_p(rest.get_mpz_t(), prime))
+          {
+            mpz_divexact_ui(rest.get_mpz_t(), rest.get_mpz_t(), prime);
+            primes.push_back(prime);
+          }
+    }
+
+  if (rest == 1)
+    return true;
+  primes.clear();
+  return false;
+}
+
+mp_limb_t NTT_Data::power(mp_limb_t x, mp_limb_t e) const
+{
+  mp_limb_t res = 1;
+  for (; e; e >>= 1)
+    {
+      if (e & 1)
+        res = mul(res, x);
+      x = mul(x, x);
+    }
+  return res;
+}
+
+mp_limb_t NTT_Data::find_root() const
+{
+  // same as Find_Primitive_Root_2power()
+  mp_limb_t exp = (q - 1) / (2 * n);
+  for (mp_limb_t base = 2; base < q; base++)
+    {
+      mp_limb_t root = power(base, exp);
+      if (power(root, n) == q - 1)
+        return root;
+    }
+  throw runtime_error("no root of unity");
+}
+
+void NTT_Data::init(int n, mp_limb_t q)
+{
+  this->n = n;
+  this->q = q;
+  logn = numBits(n) - 1;
+  assert(n == 1 << logn);
+  assert(q % (2 * n) == 1);
+  q_bits = numBits(q);
+  assert(q_bits <= MAX_BITS);
+  q_ratio = ((__uint128_t) 1 << (2 * q_bits)) / q;
+
+  reversed.resize(n);
+  for (int i = 0; i < n; i++)
+    {
+      reversed[i] = 0;
+      for (int j = 0; j < logn; j++)
+        reversed[i] |= ((i >> j) & 1) << (logn - 1 - j);
+    }
+
+  mp_limb_t root = find_root();
+  mp_limb_t iroot = power(root, q - 2);
+  psi.resize(n);
+  psi_shoup.resize(n);
+  ipsi.resize(n);
+  ipsi_shoup.resize(n);
+  mp_limb_t x = 1, ix = 1;
+  for (int i = 0; i < n; i++)
+    {
+      int j = reversed[i];
+      psi[j] = x;
+      psi_shoup[j] = shoup(x);
+      ipsi[j] = ix;
+      ipsi_shoup[j] = shoup(ix);
+      x = mul(x, root);
+      ix = mul(ix, iroot);
+    }
+
+  n_inv = power(n, q - 2);
+  n_inv_shoup = shoup(n_inv);
+}
+
+void NTT_Data::bit_reverse(mp_limb_t* a) const
+{
+  for (int i = 0; i < n; i++)
+    if (i < reversed[i])
+      swap(a[i], a[reversed[i]]);
+}
+
+void NTT_Data::forward(mp_limb_t* a) const
+{
+  mp_limb_t two_q = 2 * q;
+  int t = n;
+  for (int m = 1; m < n; m *= 2)
+    {
+      t /= 2;
+      for (int i = 0; i < m; i++)
+        {
+          mp_limb_t w = psi[m + i], w_shoup = psi_shoup[m + i];
+          mp_limb_t* x = a + 2 * i * t;
+          mp_limb_t* y = x + t;
+          for (int j = 0; j < t; j++)
+            {
+              mp_limb_t u = x[j];
+              if (u >= two_q)
+                u -= two_q;
+              mp_limb_t v = mul_shoup(y[j], w, w_shoup, q);
+              x[j] = u + v;
+              y[j] = u - v + two_q;
+            }
+        }
+    }
+
+  for (int i = 0; i < n; i++)
+    {
+      if (a[i] >= two_q)
+        a[i] -= two_q;
+      if (a[i] >= q)
+        a[i] -= q;
+    }
+
+  bit_reverse(a);
+}
+
+void NTT_Data::inverse(mp_limb_t* a) const
+{
+  bit_reverse(a);
+
+  mp_limb_t two_q = 2 * q;
+  int t = 1;
+  for (int m = n; m > 1; m /= 2)
+    {
+      int h = m / 2;
+      for (int i = 0; i < h; i++)
+        {
+          mp_limb_t w = ipsi[h + i], w_shoup = ipsi_shoup[h + i];
+          mp_limb_t* x = a + 2 * i * t;
+          mp_limb_t* y = x + t;
+          for (int j = 0; j < t; j++)
+            {
+              mp_limb_t u = x[j] + y[j];
+              if (u >= two_q)
+                u -= two_q;
+              mp_limb_t v = x[j] - y[j] + two_q;
+              x[j] = u;
+              y[j] = mul_shoup(v, w, w_shoup, q);
+            }
+        }
+      t *= 2;
+    }
+
+  for (int i = 0; i < n; i++)
+    a[i] = mul(a[i], n_inv, n_inv_shoup);
+}
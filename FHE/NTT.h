@@ -0,0 +1,121 @@
+/*
+ * NTT.h
+ *
+ */
+
+#ifndef FHE_NTT_H_
+#define FHE_NTT_H_
+
+#include "Math/bigint.h"
+
+#include <vector>
+using namespace std;
+
+/* Negacyclic number-theoretic transform modulo a word-sized prime
+ * (at most 62 bits) for power-of-two cyclotomics.
+ *
+ * The butterflies use Shoup's precomputed quotients for the twiddle
+ * factors and Harvey's lazy reduction, so values are only reduced
+ * to [0,q) at the end. Element-wise products use Barrett reduction.
+ *
+ * The root is found in the same way as Find_Primitive_Root_2power(),
+ * and the result is in the same order as FFT_Iter2, that is, entry i
+ * holds the evaluation at root^(2i+1).
+ *
+ * Ciphertext moduli for power-of-two cyclotomics are products of
+ * such primes (see generate_modulus()), and FFT_Data recognizes them
+ * by factorize() to hold ring elements as residues modulo every prime.
+ */
+class NTT_Data
+{
+  int n, logn;
+  mp_limb_t q;
+
+  // for Barrett reduction
+  int q_bits;
+  mp_limb_t q_ratio;
+
+  // powers of root and its inverse in bit-reversed order
+  vector<mp_limb_t> psi, psi_shoup, ipsi, ipsi_shoup;
+  mp_limb_t n_inv, n_inv_shoup;
+  vector<int> reversed;
+
+  mp_limb_t find_root() const;
+  void bit_reverse(mp_limb_t* a) const;
+
+  public:
+
+  static const int MAX_BITS = 62;
+  // length of the primes in generated moduli
+  static const int PRIME_BITS = 60;
+  // how many primes of a given length are considered
+  static const int MAX_PRIMES = 64;
+
+  static bool power_of_two(int m) { return m > 1 and (m & (m - 1)) == 0; }
+
+  // modulus of lg2q bits as product of primes that are 1 modulo m
+  // and do not divide avoid
+  static void generate_modulus(bigint& q, int m, int lg2q,
+      const bigint& avoid = 1);
+  // primes for the NTT modulo q if it is prime or from generate_modulus()
+  static bool factorize(vector<mp_limb_t>& primes, const bigint& q, int m);
+
+  NTT_Data() : n(0), logn(0), q(0), q_bits(0), q_ratio(0), n_inv(0),
+      n_inv_shoup(0) {}
+
+  // q has to be 1 modulo 2n
+  void init(int n, mp_limb_t q);
+
+  mp_limb_t get_prime() const { return q; }
+
+  mp_limb_t reduce(const bigint& x) const
+    { return mpz_fdiv_ui(x.get_mpz_t(), q); }
+  mp_limb_t reduce(int x) const
+    { return x >= 0 ? x % q : (q - (mp_limb_t(-(long) x) % q)) % q; }
+
+  mp_limb_t add(mp_limb_t a, mp_limb_t b) const
+    { mp_limb_t res = a + b; return res >= q ? res - q : res; }
+  mp_limb_t sub(mp_limb_t a, mp_limb_t b) const
+    { return a >= b ? a - b : a + q - b; }
+  mp_limb_t negate(mp_limb_t a) const
+    { return a ? q - a : 0; }
+  mp_limb_t mul(mp_limb_t a, mp_limb_t b) const;
+  mp_limb_t power(mp_limb_t x, mp_limb_t e) const;
+
+  // for repeated multiplication by w
+  mp_limb_t shoup(mp_limb_t w) const
+    { return ((__uint128_t) w << 64) / q; }
+  mp_limb_t mul(mp_limb_t x, mp_limb_t w, mp_limb_t w_shoup) const;
+
+  void forward(mp_limb_t* a) const;
+  void inverse(mp_limb_t* a) const;
+};
+
+// w * x mod q in [0,2q) for any x
+inline mp_limb_t mul_shoup(mp_limb_t x, mp_limb_t w, mp_limb_t w_shoup,
+    mp_limb_t q)
+{
+  mp_limb_t quot = ((__uint128_t) x * w_shoup) >> 64;
+  return x * w - quot * q;
+}
+
+inline mp_limb_t NTT_Data::mul(mp_limb_t a, mp_limb_t b) const
+{
+  __uint128_t x = (__uint128_t) a * b;
+  mp_limb_t quot = ((x >> (q_bits - 1)) * q_ratio) >> (q_bits + 1);
+  mp_limb_t res = mp_limb_t(x) - quot * q;
+  if (res >= q)
+    res -= q;
+  if (res >= q)
+    res -= q;
+  return res;
+}
+
+inline mp_limb_t NTT_Data::mul(mp_limb_t x, mp_limb_t w,
+    mp_limb_t w_shoup) const
+{
+  mp_limb_t res = mul_shoup(x, w, w_shoup, q);
+  return res >= q ? res - q : res;
+}
+
+#endif /* FHE_NTT_H_ */
@@ -50,6 +50,10 @@ Ring_Element::Ring_Element(const FFT_Data& fftd,RepType r)
 
 void Ring_Element::assign_zero()
 {
+  if (rns())
+    { residues.assign((*FFTD).get_ntt().size()*(*FFTD).phi_m(),0);
+      return;
+    }
   element.resize((*FFTD).phi_m());
   for (int i=0; i<(*FFTD).phi_m(); i++)
     { assignZero(element[i],(*FFTD).get_prD()); }
@@ -58,6 +62,14 @@ void Ring_Element::assign_zero()
 
 void Ring_Element::assign_one()
 {
+  if (rns())
+    { assign_zero();
+      for (size_t j=0; j<(*FFTD).get_ntt().size(); j++)
+        { if (rep==polynomial) { residue(j)[0]=1; }
+          else { fill(residue(j),residue(j)+(*FFTD).phi_m(),1); }
+        }
+      return;
+    }
   element.resize((*FFTD).phi_m());
   modp fill;
   if (rep==polynomial) { assignZero(fill,(*FFTD).get_prD()); }
@@ -71,6 +83,15 @@ void Ring_Element::assign_one()
 
 void Ring_Element::negate()
 {
+  if (rns())
+    { for (size_t j=0; j<(*FFTD).get_ntt().size(); j++)
+        { const NTT_Data& ntt=(*FFTD).get_ntt()[j];
+          mp_limb_t* x=residue(j);
+          for (int i=0; i<(*FFTD).phi_m(); i++)
+            { x[i]=ntt.negate(x[i]); }
+        }
+      return;
+    }
   for (int i=0; i<(*FFTD).phi_m(); i++)
     { Negate(element[i],element[i],(*FFTD).get_prD()); }
 }
@@ -82,8 +103,18 @@ void add(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
   if (a.rep!=b.rep)   { throw rep_mismatch(); }
   if (a.FFTD!=b.FFTD) { throw pr_mismatch();  }  
   ans.partial_assign(a);
-  for (int i=0; i<(*ans.FFTD).phi_m(); i++)
-    { Add(ans.element[i],a.element[i],b.element[i],(*a.FFTD).get_prD()); }
+  if (ans.rns())
+    { for (size_t j=0; j<(*ans.FFTD).get_ntt().size(); j++)
+        { const NTT_Data& ntt=(*ans.FFTD).get_ntt()[j];
+          mp_limb_t* x=ans.residue(j);
+          const mp_limb_t *y=a.residue(j),*z=b.residue(j);
+          for (int i=0; i<(*ans.FFTD).phi_m(); i++)
+            { x[i]=ntt.add(y[i],z[i]); }
+        }
+      return;
+    }
+  (*a.FFTD).get_prD().Add(ans.element.data(),a.element.data(),
+      b.element.data(),(*ans.FFTD).phi_m());
 }
 
 
@@ -93,8 +124,18 @@ void sub(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
   if (a.rep!=b.rep)   { throw rep_mismatch(); }
   if (a.FFTD!=b.FFTD) { throw pr_mismatch();  }
   ans.partial_assign(a);
-  for (int i=0; i<(*ans.FFTD).phi_m(); i++)
-    { Sub(ans.element[i],a.element[i],b.element[i],(*a.FFTD).get_prD()); }
+  if (ans.rns())
+    { for (size_t j=0; j<(*ans.FFTD).get_ntt().size(); j++)
+        { const NTT_Data& ntt=(*ans.FFTD).get_ntt()[j];
+          mp_limb_t* x=ans.residue(j);
+          const mp_limb_t *y=a.residue(j),*z=b.residue(j);
+          for (int i=0; i<(*ans.FFTD).phi_m(); i++)
+            { x[i]=ntt.sub(y[i],z[i]); }
+        }
+      return;
+    }
+  (*a.FFTD).get_prD().Sub(ans.element.data(),a.element.data(),
+      b.element.data(),(*ans.FFTD).phi_m());
 }
 
 
@@ -104,10 +145,19 @@ void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
   if (a.rep!=b.rep)   { throw rep_mismatch(); }
   if (a.FFTD!=b.FFTD) { throw pr_mismatch();  }
   ans.partial_assign(a);
-  if (ans.rep==evaluation)
+  if (ans.rep==evaluation and ans.rns())
+    { for (size_t j=0; j<(*ans.FFTD).get_ntt().size(); j++)
+        { const NTT_Data& ntt=(*ans.FFTD).get_ntt()[j];
+          mp_limb_t* x=ans.residue(j);
+          const mp_limb_t *y=a.residue(j),*z=b.residue(j);
+          for (int i=0; i<(*ans.FFTD).phi_m(); i++)
+            { x[i]=ntt.mul(y[i],z[i]); }
+        }
+    }
+  else if (ans.rep==evaluation)
     { // In evaluation representation, so we can just multiply componentwise
-      for (int i=0; i<(*ans.FFTD).phi_m(); i++)
-        { Mul(ans.element[i],a.element[i],b.element[i],(*a.FFTD).get_prD()); }
+      (*a.FFTD).get_prD().Mul(ans.element.data(),a.element.data(),
+          b.element.data(),(*ans.FFTD).phi_m());
     }
   else if ((*ans.FFTD).get_twop()!=0)
     { // This is the case where m is not a power of two
@@ -138,21 +188,12 @@ void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
        { ans.element[i]=aa[i]; }
     }
   else if ((*ans.FFTD).get_twop()==0)
-    { // m a power of two case
-      Ring_Element aa(*ans.FFTD,ans.rep);
-      modp temp;
-      for (int i=0; i<(*ans.FFTD).phi_m(); i++)
-        { for (int j=0; j<(*ans.FFTD).phi_m(); j++)
-            { Mul(temp,a.element[i],b.element[j],(*a.FFTD).get_prD());
-              int k=i+j;
-              if (k>=(*ans.FFTD).phi_m())
-                 { k-=(*ans.FFTD).phi_m();
-                   Negate(temp,temp,(*a.FFTD).get_prD());
-                 }
-              Add(aa.element[k],aa.element[k],temp,(*a.FFTD).get_prD());
-            }
-        }
-      ans=aa;
+    { // m a power of two case, go via the evaluation representation
+      Ring_Element aa(a),bb(b);
+      aa.change_rep(evaluation);
+      bb.change_rep(evaluation);
+      mul(ans,aa,bb);
+      ans.change_rep(polynomial);
     }
   else
     { throw not_implemented(); }
@@ -162,6 +203,19 @@ void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
 void mul(Ring_Element& ans,const Ring_Element& a,const modp& b)
 {
   ans.partial_assign(a);
+  if (ans.rns())
+    { bigint bb;
+      to_bigint(bb,b,(*a.FFTD).get_prD());
+      for (size_t j=0; j<(*ans.FFTD).get_ntt().size(); j++)
+        { const NTT_Data& ntt=(*ans.FFTD).get_ntt()[j];
+          mp_limb_t w=ntt.reduce(bb),w_shoup=ntt.shoup(w);
+          mp_limb_t* x=ans.residue(j);
+          const mp_limb_t* y=a.residue(j);
+          for (int i=0; i<(*ans.FFTD).phi_m(); i++)
+            { x[i]=ntt.mul(y[i],w,w_shoup); }
+        }
+      return;
+    }
   for (int i=0; i<(*ans.FFTD).phi_m(); i++)
     { Mul(ans.element[i],a.element[i],b,(*a.FFTD).get_prD()); }
 }
@@ -170,6 +224,20 @@ void mul(Ring_Element& ans,const Ring_Element& a,const modp& b)
 
 void Ring_Element::randomize(PRNG& G,bool Diag)
 {
+  if (rns())
+    { // uniform modulo each prime is uniform modulo the product
+      int n=(*FFTD).phi_m();
+      for (size_t j=0; j<(*FFTD).get_ntt().size(); j++)
+        { mp_limb_t q=(*FFTD).get_ntt()[j].get_prime();
+          mp_limb_t mask=(mp_limb_t(1)<<numBits(q))-1;
+          mp_limb_t* x=residue(j);
+          for (int i=0; i<(Diag ? 1 : n); i++)
+            { do { x[i]=G.get_word()&mask; } while (x[i]>=q); }
+          if (Diag)
+            { fill(x+1,x+n,rep==polynomial ? 0 : x[0]); }
+        }
+      return;
+    }
   if (Diag==false)
     { for (int i=0; i<(*FFTD).phi_m(); i++) 
        { element[i].randomize(G,(*FFTD).get_prD()); }
@@ -195,7 +263,7 @@ ostream& operator<<(ostream& s,const Ring_Element& e)
   else                   { s << "E "; }
   bigint te;
   for (int i=0; i<(*e.FFTD).phi_m(); i++) 
-    { to_bigint(te,e.element[i],(*e.FFTD).get_prD());
+    { e.get_element(te,i);
       s << te << " ";
     }
   s << "]";
@@ -209,6 +277,7 @@ ostream& operator<<(ostream& s,const Ring_Element& e)
 istream& operator>>(istream& s, Ring_Element& e)
 {
   vector<modp> elem;
+  vector<bigint> values;
   bigint cur;
   RepType rep;
   int ch = s.get();
@@ -239,8 +308,12 @@ istream& operator>>(istream& s, Ring_Element& e)
       if (!(s >> cur))
           { throw IO_Error("Bad Ring_Element input"); }
       
-      to_modp(te,cur,(*e.FFTD).get_prD());
-      elem.push_back(te);
+      if (e.rns())
+        { values.push_back(cur); }
+      else
+        { to_modp(te,cur,(*e.FFTD).get_prD());
+          elem.push_back(te);
+        }
       
       ch = s.peek();
       while (isspace(ch))
@@ -251,7 +324,15 @@ istream& operator>>(istream& s, Ring_Element& e)
   }
   s.get();
   
-  e.element = elem;
+  if (e.rns())
+    { if ((int)values.size()!=(*e.FFTD).phi_m())
+        { throw IO_Error("Bad Ring_Element input: wrong length"); }
+      e.residues.resize((*e.FFTD).get_ntt().size()*(*e.FFTD).phi_m());
+      for (size_t i=0; i<values.size(); i++)
+        { e.set_element(i,values[i]); }
+    }
+  else
+    { e.element = elem; }
   return s;
 }
 
@@ -261,7 +342,12 @@ void Ring_Element::change_rep(RepType r)
   if (rep==r) { return; }
   if (r==evaluation)
     { rep=evaluation;
-      if ((*FFTD).get_twop()==0)
+      if (rns())
+        { // m a power of two and word-sized primes
+          for (size_t j=0; j<(*FFTD).get_ntt().size(); j++)
+            { (*FFTD).get_ntt()[j].forward(residue(j)); }
+        }
+      else if ((*FFTD).get_twop()==0)
         { // m a power of two variant
           FFT_Iter2(element,(*FFTD).phi_m(),(*FFTD).get_root(0),(*FFTD).get_prD());
 	}
@@ -275,7 +361,12 @@ void Ring_Element::change_rep(RepType r)
     }
   else
     { rep=polynomial;
-      if ((*FFTD).get_twop()==0)
+      if (rns())
+        { // m a power of two and word-sized primes
+          for (size_t j=0; j<(*FFTD).get_ntt().size(); j++)
+            { (*FFTD).get_ntt()[j].inverse(residue(j)); }
+        }
+      else if ((*FFTD).get_twop()==0)
 	{ // m a power of two variant
           modp root2;
           Sqr(root2,(*FFTD).get_root(1),(*FFTD).get_prD());
@@ -309,6 +400,8 @@ bool Ring_Element::equals(const Ring_Element& a) const
 {
   if (rep!=a.rep)   { throw rep_mismatch(); }
   if (*FFTD!=*a.FFTD) { throw pr_mismatch();  }
+  if (rns())
+    { return residues==a.residues; }
   for (int i=0; i<(*FFTD).phi_m(); i++)
     { if (!areEqual(element[i],a.element[i],(*FFTD).get_prD())) { return false; } }
   return true;
@@ -319,6 +412,13 @@ void Ring_Element::from_vec(const vector<bigint>& v)
 {
   RepType t=rep;
   rep=polynomial;
+  if (rns())
+    { residues.resize((*FFTD).get_ntt().size()*(*FFTD).phi_m());
+      for (int i=0; i<(*FFTD).phi_m(); i++)
+        { set_element(i,v[i]); }
+      change_rep(t);
+      return;
+    }
   bigint tmp;
   for (int i=0; i<(*FFTD).phi_m(); i++)
     {
@@ -333,6 +433,17 @@ void Ring_Element::from_vec(const vector<int>& v)
 {
   RepType t=rep;
   rep=polynomial;
+  if (rns())
+    { residues.resize((*FFTD).get_ntt().size()*(*FFTD).phi_m());
+      for (size_t j=0; j<(*FFTD).get_ntt().size(); j++)
+        { const NTT_Data& ntt=(*FFTD).get_ntt()[j];
+          mp_limb_t* x=residue(j);
+          for (int i=0; i<(*FFTD).phi_m(); i++)
+            { x[i]=ntt.reduce(v[i]); }
+        }
+      change_rep(t);
+      return;
+    }
   for (int i=0; i<(*FFTD).phi_m(); i++)
     { to_modp(element[i],v[i],(*FFTD).get_prD()); }
   change_rep(t);
@@ -345,6 +456,18 @@ void Ring_Element::from(const Generator<T>& generator)
   RepType t=rep;
   rep=polynomial;
   T tmp;
+  if (rns())
+    { auto& ntt=(*FFTD).get_ntt();
+      int n=(*FFTD).phi_m();
+      residues.resize(ntt.size()*n);
+      for (int i=0; i<n; i++)
+        { generator.get(tmp);
+          for (size_t j=0; j<ntt.size(); j++)
+            { residues[j*n+i]=ntt[j].reduce(tmp); }
+        }
+      change_rep(t);
+      return;
+    }
   for (int i=0; i<(*FFTD).phi_m(); i++)
     {
       generator.get(tmp);
@@ -357,7 +480,7 @@ ConversionIterator Ring_Element::get_iterator() const
 {
   if (rep != polynomial)
     throw runtime_error("simple iterator only available in polynomial represention");
-  return {element, (*FFTD).get_prD()};
+  return *this;
 }
 
 RingReadIterator Ring_Element::get_copy_iterator() const
@@ -383,13 +506,13 @@ void Ring_Element::to_vec_bigint(vector<bigint>& v) const
   v.resize(FFTD->phi_m());
   if (rep==polynomial)
      { for (int i=0; i<(*FFTD).phi_m(); i++)
-         { to_bigint(v[i],element[i],(*FFTD).get_prD()); }
+         { get_element(v[i],i); }
      }
   else
      { Ring_Element a=*this;
        a.change_rep(polynomial);
        for (int i=0; i<(*FFTD).phi_m(); i++)
-         { to_bigint(v[i],a.element[i],(*FFTD).get_prD()); }
+         { a.get_element(v[i],i); }
      }
 }
 
@@ -400,10 +523,71 @@ void Ring_Element::to_vec_bigint(vector<bigint>& v) const
 modp Ring_Element::get_constant() const
 {
   if (rep==polynomial)
-     { return element[0]; }
+     { return get_element(0); }
   Ring_Element a=*this;
   a.change_rep(polynomial);
-  return a.element[0]; 
+  return a.get_element(0); 
+}
+
+
+modp Ring_Element::get_element(int i) const
+{
+  if (rns())
+    { bigint tmp;
+      modp ans;
+      get_element(tmp,i);
+      to_modp(ans,tmp,(*FFTD).get_prD());
+      return ans;
+    }
+  return element[i];
+}
+
+
+void Ring_Element::set_element(int i,const modp& a)
+{
+  if (rns())
+    { bigint tmp;
+      to_bigint(tmp,a,(*FFTD).get_prD());
+      set_element(i,tmp);
+    }
+  else
+    { element[i]=a; }
+}
+
+
+void Ring_Element::get_element(bigint& ans,int i) const
+{
+  if (rns())
+    { (*FFTD).from_rns(ans,&residues[i],(*FFTD).phi_m()); }
+  else
+    { to_bigint(ans,element[i],(*FFTD).get_prD()); }
+}
+
+
+void Ring_Element::set_element(int i,const bigint& a)
+{
+  if (rns())
+    { (*FFTD).to_rns(&residues[i],a,(*FFTD).phi_m()); }
+  else
+    { to_modp(element[i],a,(*FFTD).get_prD()); }
+}
+
+
+void Ring_Element::get_modp(vector<modp>& v) const
+{
+  v.resize((*FFTD).phi_m());
+  for (size_t i=0; i<v.size(); i++)
+    { v[i]=get_element(i); }
+}
+
+
+void Ring_Element::set_modp(const vector<modp>& v)
+{
+  if ((int)v.size()!=(*FFTD).phi_m())
+    throw runtime_error("invalid element size");
+  residues.resize((*FFTD).get_ntt().size()*(*FFTD).phi_m());
+  for (size_t i=0; i<v.size(); i++)
+    { set_element(i,v[i]); }
 }
 
 
@@ -430,7 +614,13 @@ void Ring_Element::pack(octetStream& o) const
 {
   check_size();
   o.store(rep);
-  store(o,element,(*FFTD).get_prD());
+  if (rns())
+    { vector<modp> v;
+      get_modp(v);
+      store(o,v,(*FFTD).get_prD());
+    }
+  else
+    { store(o,element,(*FFTD).get_prD()); }
 }
 
 
@@ -440,7 +630,13 @@ void Ring_Element::unpack(octetStream& o)
   o.get(a);
   rep=(RepType) a;
   check_rep();
-  get(o,element,(*FFTD).get_prD());
+  if (rns())
+    { vector<modp> v;
+      get(o,v,(*FFTD).get_prD());
+      set_modp(v);
+    }
+  else
+    { get(o,element,(*FFTD).get_prD()); }
   check_size();
 }
 
@@ -454,16 +650,22 @@ void Ring_Element::check_rep()
 
 void Ring_Element::check_size() const
 {
-  if ((int)element.size() != FFTD->phi_m())
+  size_t size = rns() ? residues.size() / FFTD->get_ntt().size() :
+      element.size();
+  if ((int)size != FFTD->phi_m())
     throw runtime_error("invalid element size");
 }
 
 void Ring_Element::output(ostream& s) const
 {
+  vector<modp> v;
+  if (rns())
+    get_modp(v);
+  auto& elem = rns() ? v : element;
   s.write((char*)&rep, sizeof(rep));
-  auto size = element.size();
+  auto size = elem.size();
   s.write((char*)&size, sizeof(size));
-  for (auto& x : element)
+  for (auto& x : elem)
     x.output(s, FFTD->get_prD(), false);
 }
 
@@ -472,11 +674,15 @@ void Ring_Element::input(istream& s)
 {
   s.read((char*)&rep, sizeof(rep));
   check_rep();
-  auto size = element.size();
+  vector<modp> v;
+  auto& elem = rns() ? v : element;
+  auto size = elem.size();
   s.read((char*)&size, sizeof(size));
-  element.resize(size);
-  for (auto& x : element)
+  elem.resize(size);
+  for (auto& x : elem)
     x.input(s, FFTD->get_prD(), false);
+  if (rns())
+    set_modp(v);
 }
 
 
@@ -489,7 +695,10 @@ void Ring_Element::check(const FFT_Data& FFTD) const
 
 size_t Ring_Element::report_size(ReportType type) const
 {
-  if (type == CAPACITY)
+  if (rns())
+    return sizeof(mp_limb_t) *
+        (type == CAPACITY ? residues.capacity() : residues.size());
+  else if (type == CAPACITY)
     return sizeof(modp) * element.capacity();
   else
     return sizeof(mp_limb_t) * (*FFTD).get_prD().get_t() * element.size();
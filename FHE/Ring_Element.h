@@ -22,6 +22,8 @@ enum RepType { polynomial, evaluation };
 #include <vector>
 using namespace std;
 
+class ConversionIterator;
+class WriteConversionIterator;
 class RingWriteIterator;
 class RingReadIterator;
 
@@ -37,23 +39,38 @@ class Ring_Element
 
   /* In either representation we hold the element as an array of
    * modp's of length Ring.phi_m()
+   *
+   * If FFTD->rns(), we instead hold the residues modulo each prime
+   * in turn, and element is empty
    */
 
   vector<modp> element; 
+  vector<mp_limb_t> residues;
 
   // Define a copy
   void assign(const Ring_Element& e)
     { rep=e.rep; FFTD=e.FFTD;
       element=e.element;
+      residues=e.residues;
     }
 
+  bool rns() const { return (*FFTD).rns(); }
+  mp_limb_t* residue(int i) { return &residues[i*(*FFTD).phi_m()]; }
+  const mp_limb_t* residue(int i) const { return &residues[i*(*FFTD).phi_m()]; }
+
+  // With RNS, convert to and from the representation without
+  void get_modp(vector<modp>& v) const;
+  void set_modp(const vector<modp>& v);
+
   public:
 
   // Used to basically make sure *this is able to cope
   // with being assigned to by something of "type" e
   void partial_assign(const Ring_Element& e)
     { rep=e.rep; FFTD=e.FFTD; 
-      if (FFTD)
+      if (FFTD and rns())
+        residues.resize((*FFTD).get_ntt().size()*(*FFTD).phi_m());
+      else if (FFTD)
         element.resize((*FFTD).phi_m());
     }
 
@@ -118,8 +135,10 @@ class Ring_Element
 
   // This gets the constant term of the poly rep as a modp element
   modp get_constant() const;
-  modp get_element(int i) const { return element[i]; }
-  void set_element(int i,const modp& a) { element[i]=a; }
+  modp get_element(int i) const;
+  void set_element(int i,const modp& a);
+  void get_element(bigint& ans,int i) const;
+  void set_element(int i,const bigint& a);
 
   friend ostream& operator<<(ostream& s,const Ring_Element& e);
   friend istream& operator>>(istream& s, Ring_Element& e);
@@ -142,13 +161,37 @@ class Ring_Element
 };
 
 
+class ConversionIterator : public Generator<bigint>
+{
+    const Ring_Element& element;
+    mutable int i;
+
+public:
+    ConversionIterator(const Ring_Element& element) : element(element), i(0) {}
+    Generator<bigint>* clone() const { return new ConversionIterator(*this); }
+    void get(bigint& x) const { element.get_element(x, i); i++; }
+};
+
+
+class WriteConversionIterator : public Generator<bigint>
+{
+    Ring_Element& element;
+    mutable int i;
+
+public:
+    WriteConversionIterator(Ring_Element& element) : element(element), i(0) {}
+    Generator<bigint>* clone() const { return new WriteConversionIterator(*this); }
+    void get(bigint& x) const { element.set_element(i, x); i++; }
+};
+
+
 class RingWriteIterator : public WriteConversionIterator
 {
   Ring_Element& element;
   RepType rep;
 public:
   RingWriteIterator(Ring_Element& element) :
-    WriteConversionIterator(element.element, element.FFTD->get_prD()),
+    WriteConversionIterator(element),
     element(element), rep(element.rep) { element.rep = polynomial; }
   ~RingWriteIterator() { element.change_rep(rep); }
 };
@@ -159,7 +202,7 @@ class RingReadIterator : public ConversionIterator
   Ring_Element element;
 public:
   RingReadIterator(const Ring_Element& element) :
-    ConversionIterator(this->element.element, element.FFTD->get_prD()),
+    ConversionIterator(this->element),
     element(element) { this->element.change_rep(polynomial); }
 };
 
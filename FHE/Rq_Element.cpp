@@ -258,7 +258,7 @@ void Rq_Element::change_rep(RepType r0,RepType r1)
   a[1].change_rep(r1);
 }
 
-void Rq_Element::Scale(const bigint& p)
+void Rq_Element::Scale(const bigint& p, bool key_switched)
 {
   if (lev==0) { return; }
   if (n_mults() == 0) {
@@ -268,14 +268,17 @@ void Rq_Element::Scale(const bigint& p)
   bigint p0=a[0].get_prime(),p1=a[1].get_prime(),p1i,lambda,n=p1*p;
   invMod(p1i,p1%p,p);
 
-  // First multiply input by [p1]_p
+  // First multiply input by [p1]_p unless it has been multiplied by p1,
+  // which is a no-op if p1 = 1 mod p
   bigint te=p1%p;
   if (te>p/2) { te-=p; }
-  modp tep;
-  to_modp(tep,te,a[0].get_prD());
-  mul(a[0],a[0],tep);
-  to_modp(tep,te,a[1].get_prD());
-  mul(a[1],a[1],tep);
+  if (te!=1 and not key_switched)
+    { modp tep;
+      to_modp(tep,te,a[0].get_prD());
+      mul(a[0],a[0],tep);
+      to_modp(tep,te,a[1].get_prD());
+      mul(a[1],a[1],tep);
+    }
 
   // Now compute delta
   Ring_Element b0(a[0].get_FFTD(),evaluation);
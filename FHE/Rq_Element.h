@@ -97,7 +97,8 @@ protected:
   void randomize(PRNG& G,int lev=-1);
 
   // Scale from level 1 to level 0, if at level 0 do nothing
-  void Scale(const bigint& p);
+  // After key switching, the plaintext is already multiplied by p1
+  void Scale(const bigint& p, bool key_switched = false);
 
   bool equals(const Rq_Element& a) const;
   bool operator!=(const Rq_Element& a) const { return !equals(a); }
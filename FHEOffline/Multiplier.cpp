@@ -16,33 +16,36 @@ Multiplier<FD>::Multiplier(int offset, PairwiseGenerator<FD>& generator) :
     other_pk(machine.other_pks[(my_num + num_players - offset) % num_players]),
     other_enc_alpha(machine.enc_alphas[(my_num + num_players - offset) % num_players]),
     timers(generator.timers),
-    C(machine.pk), mask(machine.pk),
-    product_share(machine.setup<FD>().FieldD), rc(machine.pk),
+    C(BATCH_SIZE, machine.pk),
+    mask(BATCH_SIZE, machine.pk),
+    product_share(BATCH_SIZE, machine.setup<FD>().FieldD),
+    rc(BATCH_SIZE, machine.pk),
     volatile_capacity(0)
 {
     product_share.allocate_slots(machine.setup<FD>().params.p0() << 64);
 }
 
 template <class FD>
-void Multiplier<FD>::multiply_and_add(Plaintext_<FD>& res,
-        const Ciphertext& enc_a, const Plaintext_<FD>& b)
+void Multiplier<FD>::multiply_and_add(PlaintextVector<FD>& res,
+        const vector<Ciphertext>& enc_a, const AddableVector<Rq_Element>& b)
 {
-    Rq_Element bb(enc_a.get_params(), evaluation, evaluation);
-    bb.from_vec(b.get_poly());
-    multiply_and_add(res, enc_a, bb);
+    add_products(res, [&](size_t i) -> const Ciphertext& { return enc_a.at(i); },
+            b);
 }
 
 template <class FD>
-void Multiplier<FD>::multiply_and_add(Plaintext_<FD>& res,
-        const Ciphertext& enc_a, const Rq_Element& b)
+void Multiplier<FD>::multiply_alpha_and_add(PlaintextVector<FD>& res,
+        const AddableVector<Rq_Element>& b)
+{
+    add_products(res, [&](size_t) -> const Ciphertext& { return other_enc_alpha; },
+            b);
+}
+
+template <class FD>
+void Multiplier<FD>::add_products(PlaintextVector<FD>& res,
+        function<const Ciphertext&(size_t)> enc_a,
+        const AddableVector<Rq_Element>& b)
 {
-    PRNG G;
-    G.ReSeed();
-    timers["Ciphertext multiplication"].start();
-    C.mul(enc_a, b);
-    timers["Ciphertext multiplication"].stop();
-    timers["Mask randomization"].start();
-    product_share.randomize(G);
     bigint B = 6 * machine.setup<FD>().params.get_R();
     B *= machine.setup<FD>().FieldD.get_prime();
     B <<= machine.sec;
@@ -50,41 +53,61 @@ void Multiplier<FD>::multiply_and_add(Plaintext_<FD>& res,
     B *= NonInteractiveProof::slack(machine.sec,
             machine.setup<FD>().params.phi_m());
     B <<= machine.extra_slack;
-    rc.generateUniform(G, 0, B, B);
-    timers["Mask randomization"].stop();
-    timers["Encryption"].start();
-    other_pk.encrypt(mask, product_share, rc);
-    timers["Encryption"].stop();
-    timers["Multiplied ciphertext sending"].start();
-    octetStream o;
-    mask += C;
-    mask.pack(o);
-    P.reverse_exchange(o);
-    C.unpack(o);
-    timers["Multiplied ciphertext sending"].stop();
-    timers["Decryption"].start();
-    res -= product_share;
-    machine.sk.decrypt_any(product_share, C);
-    res += product_share;
-    timers["Decryption"].stop();
-    memory_usage.update("multiplied ciphertext", C.report_size(CAPACITY));
-    memory_usage.update("mask ciphertext", mask.report_size(CAPACITY));
-    memory_usage.update("product shares", product_share.report_size(CAPACITY));
-    memory_usage.update("masking random coins", rc.report_size(CAPACITY));
-}
 
-template <class FD>
-void Multiplier<FD>::multiply_alpha_and_add(Plaintext_<FD>& res,
-        const Rq_Element& b)
-{
-    multiply_and_add(res, other_enc_alpha, b);
+    // fixed batches with one exchange each, processed by as many threads
+    // as available
+    for (size_t start = 0; start < b.size(); start += C.size())
+    {
+        size_t n = min(C.size(), b.size() - start);
+        timers["Ciphertext multiplication and masking"].start();
+        machine.pool.parallel_for(n, [&](size_t i)
+        {
+            PRNG G;
+            G.ReSeed();
+            // both operands are in evaluation representation
+            C[i].mul(enc_a(start + i), b.at(start + i));
+            product_share[i].randomize(G);
+            rc[i].generateUniform(G, 0, B, B);
+            other_pk.encrypt(mask[i], product_share[i], rc[i]);
+            mask[i] += C[i];
+        });
+        timers["Ciphertext multiplication and masking"].stop();
+        timers["Multiplied ciphertext sending"].start();
+        octetStream o;
+        for (size_t i = 0; i < n; i++)
+            mask[i].pack(o);
+        P.reverse_exchange(o);
+        for (size_t i = 0; i < n; i++)
+            C[i].unpack(o);
+        timers["Multiplied ciphertext sending"].stop();
+        timers["Decryption"].start();
+        machine.pool.parallel_for(n, [&](size_t i)
+        {
+            auto& x = res.at(start + i);
+            x -= product_share[i];
+            machine.sk.decrypt_any(product_share[i], C[i]);
+            x += product_share[i];
+        });
+        timers["Decryption"].stop();
+    }
+
+    memory_usage.update("multiplied ciphertexts", C.report_size(CAPACITY));
+    memory_usage.update("mask ciphertexts", mask.report_size(CAPACITY));
+    memory_usage.update("product shares", product_share.report_size(CAPACITY));
+    size_t coins_size = 0;
+    for (auto& x : rc)
+        coins_size += x.report_size(CAPACITY);
+    memory_usage.update("masking random coins", coins_size);
 }
 
 template <class FD>
 size_t Multiplier<FD>::report_size(ReportType type)
 {
-    return C.report_size(type) + mask.report_size(type)
-            + product_share.report_size(type) + rc.report_size(type);
+    size_t res = C.report_size(type) + mask.report_size(type)
+            + product_share.report_size(type);
+    for (auto& x : rc)
+        res += x.report_size(type);
+    return res;
 }
 
 template <class FD>
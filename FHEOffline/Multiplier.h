@@ -6,6 +6,9 @@
 #ifndef FHEOFFLINE_MULTIPLIER_H_
 #define FHEOFFLINE_MULTIPLIER_H_
 
+#include <functional>
+using namespace std;
+
 #include "FHEOffline/SimpleEncCommit.h"
 #include "FHE/AddableVector.h"
 #include "Tools/MemoryUsage.h"
@@ -28,21 +31,29 @@ class Multiplier
     const Ciphertext& other_enc_alpha;
     map<string, Timer>& timers;
 
-    // temporary
-    Ciphertext C, mask;
-    Plaintext_<FD> product_share;
-    Random_Coins rc;
+    // temporary, one per product computed in parallel
+    AddableVector<Ciphertext> C, mask;
+    PlaintextVector<FD> product_share;
+    vector<Random_Coins> rc;
 
     size_t volatile_capacity;
     MemoryUsage memory_usage;
 
+    void add_products(PlaintextVector<FD>& res,
+            function<const Ciphertext&(size_t)> C,
+            const AddableVector<Rq_Element>& b);
+
 public:
+    // products per exchange, independent of the number of threads so
+    // that all parties agree on the message sizes
+    static const int BATCH_SIZE = 6;
+
     Multiplier(int offset, PairwiseGenerator<FD>& generator);
-    void multiply_and_add(Plaintext_<FD>& res, const Ciphertext& C,
-            const Plaintext_<FD>& b);
-    void multiply_and_add(Plaintext_<FD>& res, const Ciphertext& C,
-            const Rq_Element& b);
-    void multiply_alpha_and_add(Plaintext_<FD>& res, const Rq_Element& b);
+    // res[i] += C[i] * b[i] for all i < b.size()
+    void multiply_and_add(PlaintextVector<FD>& res, const vector<Ciphertext>& C,
+            const AddableVector<Rq_Element>& b);
+    void multiply_alpha_and_add(PlaintextVector<FD>& res,
+            const AddableVector<Rq_Element>& b);
     int get_offset() { return P.get_offset(); }
     size_t report_size(ReportType type);
     void report_size(ReportType type, MemoryUsage& res);
@@ -31,6 +31,8 @@ PairwiseGenerator<FD>::PairwiseGenerator(int thread_num,
     c.allocate_slots((bigint)FieldD.get_prime() << 64);
     b_mod_q.resize(machine.sec,
     { machine.setup<FD>().params, evaluation, evaluation });
+    // MACs of a, b, and c for one batch of products at a time
+    n_parallel = min(machine.sec, Multiplier<FD>::BATCH_SIZE / 3);
 }
 
 template <class FD>
@@ -46,8 +48,9 @@ void PairwiseGenerator<FD>::run()
     PRNG G;
     G.ReSeed();
     MAC_Check<typename FD::T> MC(machine.setup<FD>().alphai);
+    PlaintextVector<FD>* triple[] = { &a, &b, &c };
 
-    while (total < machine.nTriplesPerThread)
+    while (stream ? not stream_closed() : total < machine.nTriplesPerThread)
     {
         timers["Randomization"].start();
         a.randomize(G);
@@ -66,33 +69,43 @@ void PairwiseGenerator<FD>::run()
         timers["Proof exchange"].stop();
         volatile_memory = max(prover_memory, verifier_memory);
 
-        Rq_Element values({machine.setup<FD>().params, evaluation, evaluation});
-        for (int k = 0; k < machine.sec; k++)
+        for (int k0 = 0; k0 < machine.sec; k0 += n_parallel)
         {
-            producer.ai = a[k];
-            producer.bi = b[k];
-            producer.ci = c[k];
-
-            for (int j = 0; j < 3; j++)
-            {
-                timers["Plaintext multiplication"].start();
-                producer.macs[j].mul(machine.setup<FD>().alpha, producer.values[j]);
-                timers["Plaintext multiplication"].stop();
-
-                if (j == 1)
-                    values = b_mod_q[k];
-                else
+            int n = min(n_parallel, machine.sec - k0);
+            macs.resize(3 * n, machine.setup<FD>().FieldD);
+            values.resize(3 * n,
+                    { machine.setup<FD>().params, evaluation, evaluation });
+            for (int k = 0; k < n; k++)
+                for (int j = 0; j < 3; j++)
                 {
-                    timers["Plaintext conversion"].start();
-                    values.from_vec(producer.values[j].get_poly());
-                    timers["Plaintext conversion"].stop();
+                    auto& value = triple[j]->at(k0 + k);
+                    timers["Plaintext multiplication"].start();
+                    macs[3 * k + j].mul(machine.setup<FD>().alpha, value);
+                    timers["Plaintext multiplication"].stop();
+
+                    if (j == 1)
+                        values[3 * k + j] = b_mod_q[k0 + k];
+                    else
+                    {
+                        timers["Plaintext conversion"].start();
+                        values[3 * k + j].from_vec(value.get_poly());
+                        timers["Plaintext conversion"].stop();
+                    }
                 }
 
-                for (auto m : multipliers)
-                    m->multiply_alpha_and_add(producer.macs[j], values);
+            for (auto m : multipliers)
+                m->multiply_alpha_and_add(macs, values);
+
+            for (int k = 0; k < n; k++)
+            {
+                producer.ai = a[k0 + k];
+                producer.bi = b[k0 + k];
+                producer.ci = c[k0 + k];
+                for (int j = 0; j < 3; j++)
+                    producer.macs[j] = macs[3 * k + j];
+                producer.reset();
+                total += producer.sacrifice(P, MC);
             }
-            producer.reset();
-            total += producer.sacrifice(P, MC);
         }
 
         timers["Checking"].start();
@@ -106,6 +119,16 @@ void PairwiseGenerator<FD>::run()
     timers["Networking"] = P.timer;
 }
 
+template <class FD>
+void PairwiseGenerator<FD>::set_stream(SpscRingBase* stream)
+{
+    auto tuple_stream = dynamic_cast<TupleStream<Share<typename FD::T>>*>(stream);
+    if (tuple_stream == 0)
+        throw runtime_error("wrong stream type");
+    this->stream = stream;
+    producer.set_stream(tuple_stream);
+}
+
 template <class FD>
 size_t PairwiseGenerator<FD>::report_size(ReportType type)
 {
@@ -118,6 +141,7 @@ size_t PairwiseGenerator<FD>::report_size(ReportType type)
     res += ciphertexts.get_max_length() + cleartexts.get_max_length();
     res += EC.report_size(type) + EC.volatile_memory;
     res += b_mod_q.report_size(type);
+    res += macs.report_size(type) + values.report_size(type);
     return res;
 }
 
@@ -139,6 +163,7 @@ void PairwiseGenerator<FD>::report_size(ReportType type, MemoryUsage& res)
     res.add("serialized cleartexts", cleartexts.get_max_length());
     res.add("generator volatile", volatile_memory);
     res.add("b mod p", b_mod_q.report_size(type));
+    res.add("MAC operands", macs.report_size(type) + values.report_size(type));
     res += EC.memory_usage;
 }
 
@@ -21,6 +21,10 @@ class PairwiseGenerator : public GeneratorBase
 
     PlaintextVector<FD> a, b, c;
     AddableVector<Rq_Element> b_mod_q;
+    // MACs of several triples at once for parallel multiplication
+    PlaintextVector<FD> macs;
+    AddableVector<Rq_Element> values;
+    int n_parallel;
     vector<Multiplier<FD>*> multipliers;
     TripleProducer_<FD> producer;
     MultiEncCommit<FD> EC;
@@ -39,6 +43,7 @@ public:
     ~PairwiseGenerator();
 
     void run();
+    void set_stream(SpscRingBase* stream);
     size_t report_size(ReportType type);
     void report_size(ReportType type, MemoryUsage& res);
     size_t report_sent();
@@ -13,6 +13,19 @@ PairwiseMachine::PairwiseMachine(int argc, const char** argv) :
     MachineBase(argc, argv), P(N, 0xffff << 16),
     other_pks(N.num_players(), {setup_p.params, 0}),
     pk(other_pks[N.my_num()]), sk(pk)
+{
+    init();
+}
+
+PairwiseMachine::PairwiseMachine(Names& N, int nthreads, int field_size) :
+    MachineBase(N, nthreads, field_size, DATA_TRIPLE), P(N, 0xffff << 16),
+    other_pks(N.num_players(), {setup_p.params, 0}),
+    pk(other_pks[N.my_num()]), sk(pk)
+{
+    init();
+}
+
+void PairwiseMachine::init()
 {
     if (use_gf2n)
     {
@@ -64,6 +77,9 @@ void PairwiseMachine::setup_keys()
     G.ReSeed();
     insecure("local key generation");
     KeyGen(pk, sk, G);
+    // decryption only uses the lower level, set it here instead of
+    // in concurrent decryptions
+    sk.assign(sk.s());
     vector<octetStream> os(N.num_players());
     pk.pack(os[N.my_num()]);
     P.Broadcast_Receive(os);
@@ -23,6 +23,12 @@ public:
     vector<Ciphertext> enc_alphas;
 
     PairwiseMachine(int argc, const char** argv);
+    PairwiseMachine(Names& N, int nthreads, int field_size);
+
+    void init();
+
+    bigint get_prime() { return setup_p.FieldD.get_prime(); }
+    gfp get_alphapi() { return setup_p.alphai; }
 
     template <class FD>
     void setup_keys();
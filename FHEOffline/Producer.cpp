@@ -12,7 +12,7 @@
 template<class FD>
 Producer<FD>::Producer(int output_thread, bool write_output) :
     n_slots(0), output_thread(output_thread), write_output(write_output),
-    dir(PREP_DIR)
+    dir(PREP_DIR), stream(0)
 {
 }
 
@@ -265,7 +265,7 @@ int TripleProducer<T,FD,S>::sacrifice(const Player& P, MAC_Check<T>& MC)
     this->timers["Sacrificing"].start();
     int n_triples = ai.num_slots() / 2;
     Triple_Checking(P, MC, n_triples, this->output_thread, *this,
-            this->write_output, false, this->dir);
+            this->write_output, false, this->dir, this->stream);
     this->timers["Sacrificing"].stop();
     this->n_slots = n_triples;
     return n_triples;
@@ -277,7 +277,7 @@ int InverseProducer<FD>::sacrifice(const Player& P, MAC_Check<T>& MC)
     this->timers["Sacrificing"].start();
     int n_triples = ai.num_slots();
     Inverse_Checking(P, MC, n_triples, this->output_thread, triple_producer,
-            *this, this->write_output, false, this->dir);
+            *this, this->write_output, false, this->dir, this->stream);
     this->timers["Sacrificing"].stop();
     this->n_slots = n_triples;
     return n_triples;
@@ -289,7 +289,7 @@ int SquareProducer<FD>::sacrifice(const Player& P, MAC_Check<T>& MC)
     this->timers["Sacrificing"].start();
     int n_triples = ai.num_slots() / 2;
     Square_Checking(P, MC, n_triples, this->output_thread, *this,
-            this->write_output, false, this->dir);
+            this->write_output, false, this->dir, this->stream);
     this->timers["Sacrificing"].stop();
     this->n_slots = n_triples;
     return n_triples;
@@ -300,7 +300,7 @@ int gfpBitProducer::sacrifice(const Player& P, MAC_Check<gfp>& MC)
     timers["Sacrificing"].start();
     int n_triples = bits.size();
     Bit_Checking(P, MC, n_triples, output_thread, square_producer, *this,
-            this->write_output, false, this->dir);
+            this->write_output, false, this->dir, this->stream);
     timers["Sacrificing"].stop();
     return n_triples;
 }
@@ -29,6 +29,7 @@ protected:
   int output_thread;
   bool write_output;
   string dir;
+  TupleStream<Share<typename FD::T> >* stream;
 
 public:
   typedef typename FD::T T;
@@ -51,6 +52,9 @@ public:
   virtual int sacrifice(const Player& P, MAC_Check<T>& MC) = 0;
   int num_slots() { return n_slots; }
 
+  // hand over checked tuples to a consumer in the same process
+  void set_stream(TupleStream<Share<T> >* stream) { this->stream = stream; }
+
   virtual size_t report_size(ReportType type) { (void)type; return 0; }
 };
 
@@ -5,19 +5,22 @@
 
 
 template <class FD, class U>
-Prover<FD,U>::Prover(Proof& proof, const FD& FieldD) :
-  volatile_memory(0)
+Prover<FD,U>::Prover(Proof& proof, const FD& FieldD, TaskPool& pool) :
+  pool(pool), n_threads(pool.n_workers() + 1), volatile_memory(0)
 {
   s.resize(proof.V, proof.pk->get_params());
   y.resize(proof.V, FieldD);
 #ifdef LESS_ALLOC_MORE_MEM
   s.allocate_slots(bigint(1) << proof.B_rand_length);
   y.allocate_slots(bigint(1) << proof.B_plain_length);
-  t = s[0];
-  z = y[0];
+  t.resize(n_threads, s[0]);
+  z.resize(n_threads, y[0]);
   // extra limb to prevent reallocation
-  t.allocate_slots(bigint(1) << (proof.B_rand_length + 64));
-  z.allocate_slots(bigint(1) << (proof.B_plain_length + 64));
+  for (int i = 0; i < n_threads; i++)
+    {
+      t[i].allocate_slots(bigint(1) << (proof.B_rand_length + 64));
+      z[i].allocate_slots(bigint(1) << (proof.B_plain_length + 64));
+    }
 #endif
 }
 
@@ -39,20 +42,30 @@ void Prover<FD,U>::Stage_1(const Proof& P, octetStream& ciphertexts,
 //  ZZ bd=B_plain/(pr+1);
   PRNG G;
   G.ReSeed();
-  Random_Coins rc(pk.get_params());
-  Ciphertext ciphertext(pk.get_params());
+  vector<PRNG> Gs(n_threads);
+  vector<Random_Coins> rc(n_threads, pk.get_params());
+  AddableVector<Ciphertext> ciphertext(n_threads, pk.get_params());
   ciphertexts.store(V);
-  for (int i=0; i<V; i++)
+  for (int start=0; start<V; start+=n_threads)
     {
-//      AE.randomize(Diag,binary);
-//      rd=RandPoly(phim,bd<<1);
-//      y[i]=AE.plaintext()+pr*rd;
-      y[i].randomize(G, P.B_plain_length, Diag, binary);
-      s[i].resize(3, P.phim);
-      s[i].generateUniform(G, P.B_rand_length);
-      rc.assign(s[i][0], s[i][1], s[i][2]);
-      pk.encrypt(ciphertext,y[i],rc);
-      ciphertext.pack(ciphertexts);
+      int n=min(n_threads, V-start);
+      for (int l=0; l<n; l++)
+        Gs[l].SetSeed(G);
+      pool.parallel_for(n, [&](size_t l)
+        {
+          int i=start+l;
+//          AE.randomize(Diag,binary);
+//          rd=RandPoly(phim,bd<<1);
+//          y[i]=AE.plaintext()+pr*rd;
+          y[i].randomize(Gs[l], P.B_plain_length, Diag, binary);
+          s[i].resize(3, P.phim);
+          s[i].generateUniform(Gs[l], P.B_rand_length);
+          rc[l].assign(s[i][0], s[i][1], s[i][2]);
+          pk.encrypt(ciphertext[l],y[i],rc[l]);
+        });
+      // same order as without threads
+      for (int l=0; l<n; l++)
+        ciphertext[l].pack(ciphertexts);
     }
 }
 
@@ -68,35 +81,48 @@ bool Prover<FD,U>::Stage_2(Proof& P, octetStream& cleartexts,
   cleartexts.resize_precise(allocate);
   cleartexts.reset_write_head();
 
-  unsigned int i,k;
-  int j,ee;
 #ifndef LESS_ALLOC_MORE_MEM
-  AddableVector<bigint> z;
-  AddableMatrix<bigint> t;
+  vector< AddableVector<bigint> > z(n_threads);
+  vector< AddableMatrix<bigint> > t(n_threads);
 #endif
+  vector<int> ok(n_threads);
   cleartexts.reset_write_head();
   cleartexts.store(P.V);
-  for (i=0; i<P.V; i++)
-    { z=y[i];
-      t=s[i];
-      for (k=0; k<P.sec; k++)
-        { j=(i+1)-(k+1);
-          if (j<0 || j>=(int) P.sec) { ee=0; }
-          else                       { ee=e[j]; }
-
-          if (ee!=0)
-	    {
-              z += x[j];
-	      t += r[j];
+  for (unsigned int start=0; start<P.V; start+=n_threads)
+    {
+      int n=min(n_threads, int(P.V-start));
+      // z = y + e * x for several commitments at once
+      pool.parallel_for(n, [&](size_t l)
+        {
+          unsigned int i=start+l,k;
+          int j,ee;
+          z[l]=y[i];
+          t[l]=s[i];
+          for (k=0; k<P.sec; k++)
+            { j=(i+1)-(k+1);
+              if (j<0 || j>=(int) P.sec) { ee=0; }
+              else                       { ee=e[j]; }
+
+              if (ee!=0)
+                {
+                  z[l] += x[j];
+                  t[l] += r[j];
+                }
             }
+          ok[l] = P.check_bounds(z[l], t[l], i);
+        });
+      for (int l=0; l<n; l++)
+        {
+          if (not ok[l])
+            return false;
+          z[l].pack(cleartexts);
+          t[l].pack(cleartexts);
         }
-      if (not P.check_bounds(z, t, i))
-          return false;
-      z.pack(cleartexts);
-      t.pack(cleartexts);
-   }
+    }
 #ifndef LESS_ALLOC_MORE_MEM
-  volatile_memory = t.report_size(CAPACITY) + z.report_size(CAPACITY);
+  volatile_memory = 0;
+  for (int l=0; l<n_threads; l++)
+    volatile_memory += t[l].report_size(CAPACITY) + z[l].report_size(CAPACITY);
 #endif
 #ifdef PRINT_MIN_DIST
   cout << "Minimal distance (log) " << log2(P.dist) << ", compare to " <<
@@ -152,7 +178,8 @@ size_t Prover<FD,U>::report_size(ReportType type)
   for (unsigned int i = 0; i < y.size(); i++)
     res += y[i].report_size(type);
 #ifdef LESS_ALLOC_MORE_MEM
-  res += z.report_size(type) + t.report_size(type);
+  for (int i = 0; i < n_threads; i++)
+    res += z[i].report_size(type) + t[i].report_size(type);
 #endif
   return res;
 }
@@ -164,8 +191,14 @@ void Prover<FD, U>::report_size(ReportType type, MemoryUsage& res)
   res.update("prover s", s.report_size(type));
   res.update("prover y", y.report_size(type));
 #ifdef LESS_ALLOC_MORE_MEM
-  res.update("prover z", z.report_size(type));
-  res.update("prover t", t.report_size(type));
+  size_t z_size = 0, t_size = 0;
+  for (int i = 0; i < n_threads; i++)
+    {
+      z_size += z[i].report_size(type);
+      t_size += t[i].report_size(type);
+    }
+  res.update("prover z", z_size);
+  res.update("prover t", t_size);
 #endif
   res.update("prover volatile", volatile_memory);
 }
@@ -3,6 +3,7 @@
 
 #include "Proof.h"
 #include "Tools/MemoryUsage.h"
+#include "Tools/TaskPool.h"
 
 /* Class for the prover */
 
@@ -13,15 +14,20 @@ class Prover
   Proof::Randomness s;
   AddableVector< Plaintext_<FD> > y;
 
+  /* Masks and responses are computed for as many
+     commitments at once as there are threads */
+  TaskPool& pool;
+  int n_threads;
+
 #ifdef LESS_ALLOC_MORE_MEM
-  AddableVector<bigint> z;
-  AddableMatrix<bigint> t;
+  vector< AddableVector<bigint> > z;
+  vector< AddableMatrix<bigint> > t;
 #endif
 
 public:
   size_t volatile_memory;
 
-  Prover(Proof& proof, const FD& FieldD);
+  Prover(Proof& proof, const FD& FieldD, TaskPool& pool);
 
   void Stage_1(const Proof& P, octetStream& ciphertexts, const AddableVector<Ciphertext>& c,
       const FHE_PK& pk, bool Diag,
@@ -11,6 +11,18 @@
 // The number of sacrifices to amortize at one time
 #define amortize 512
 
+// only hand over tuples after checking the MACs of the sacrifice
+template <class T>
+void push_checked(const Player& P, MAC_Check<T>& MC,
+    TupleStream<Share<T> >* stream, vector<array<Share<T>, 3> >& batch)
+{
+  if (stream)
+    {
+      MC.Check(P);
+      // fails only if the consumer has finished
+      stream->push(batch);
+    }
+}
 
 template<class T>
 inline FileSacriFactory<T>::FileSacriFactory(const char* type, const Player& P,
@@ -66,7 +78,8 @@ void Triple_Inverse_Checking(const Player& P, MAC_Check<gfp>& MC, int nm,
 template <class T>
 void Triple_Checking(const Player& P, MAC_Check<T>& MC, int nm,
     int output_thread, TripleSacriFactory< Share<T> >& factory, bool write_output,
-    bool clear, string dir)
+    bool clear, string dir,
+    TupleStream<Share<T> >* stream)
 {
   ofstream outf;
   if (write_output)
@@ -80,6 +93,7 @@ void Triple_Checking(const Player& P, MAC_Check<T>& MC, int nm,
   vector<Share<T> > a1(amortize),b1(amortize),c1(amortize);
   vector<Share<T> > a2(amortize),b2(amortize),c2(amortize);
   Share<T> temp;
+  vector<array<Share<T>, 3> > batch;
 
   // Triple checking
   int left_todo=nm; 
@@ -126,6 +140,8 @@ void Triple_Checking(const Player& P, MAC_Check<T>& MC, int nm,
               b1[i].output(outf,false);
               c1[i].output(outf,false);
             }
+          if (stream)
+            batch.push_back({{a1[i], b1[i], c1[i]}});
         }
 
       left_todo-=this_loop;
@@ -133,6 +149,7 @@ void Triple_Checking(const Player& P, MAC_Check<T>& MC, int nm,
 
   if (write_output)
     outf.close();
+  push_checked(P, MC, stream, batch);
 }
 
 
@@ -140,7 +157,8 @@ template <class T>
 void Inverse_Checking(const Player& P, MAC_Check<T>& MC, int nr,
     int output_thread, TripleSacriFactory<Share<T> >& triple_factory,
     TupleSacriFactory<Share<T> >& inverse_factor, bool write_output,
-    bool clear, string dir)
+    bool clear, string dir,
+    TupleStream<Share<T> >* stream)
 {
   ofstream outf_inv;
   if (write_output)
@@ -154,6 +172,7 @@ void Inverse_Checking(const Player& P, MAC_Check<T>& MC, int nr,
   vector<Share<T> > a1(amortize),b1(amortize),c1(amortize);
   vector<Share<T> > a2(amortize),b2(amortize),c2(amortize);
   Share<T> temp;
+  vector<array<Share<T>, 3> > batch;
 
   // Inverse checking
   int left_todo=nr;
@@ -197,6 +216,8 @@ void Inverse_Checking(const Player& P, MAC_Check<T>& MC, int nr,
               a1[i].output(outf_inv,false);
               b1[i].output(outf_inv,false);
             }
+          if (stream)
+            batch.push_back({{a1[i], b1[i]}});
         }
 
       left_todo-=this_loop;
@@ -206,6 +227,7 @@ void Inverse_Checking(const Player& P, MAC_Check<T>& MC, int nr,
     {
       outf_inv.close();
     }
+  push_checked(P, MC, stream, batch);
 }
 
 
@@ -304,7 +326,8 @@ void Square_Bit_Checking(const Player& P,MAC_Check<gfp>& MC,int ns,int nb)
 template <class T>
 void Square_Checking(const Player& P, MAC_Check<T>& MC, int ns,
         int output_thread, TupleSacriFactory<Share<T> >& square_factory,
-        bool write_output, bool clear, string dir)
+        bool write_output, bool clear, string dir,
+        TupleStream<Share<T> >* stream)
 {
   ofstream outf_s, outf_b;
   if (write_output)
@@ -319,6 +342,7 @@ void Square_Checking(const Player& P, MAC_Check<T>& MC, int ns,
   vector<T> PO(amortize);
   vector<Share<T> > f(amortize),h(amortize),a(amortize),b(amortize);
   Share<T>  temp;
+  vector<array<Share<T>, 3> > batch;
 
   // Do the square checking
   int left_todo=ns;
@@ -359,16 +383,20 @@ void Square_Checking(const Player& P, MAC_Check<T>& MC, int ns,
             {
               a[i].output(outf_s,false); b[i].output(outf_s,false);
             }
+          if (stream)
+            batch.push_back({{a[i], b[i]}});
         }
       left_todo-=this_loop;
     }
   outf_s.close(); 
+  push_checked(P, MC, stream, batch);
 }
 
 void Bit_Checking(const Player& P, MAC_Check<gfp>& MC, int nb,
         int output_thread, TupleSacriFactory<Share<gfp> >& square_factory,
         SingleSacriFactory<Share<gfp> >& bit_factory, bool write_output,
-        bool clear, string dir)
+        bool clear, string dir,
+        TupleStream<Share<gfp> >* stream)
 {
   gfp dummy;
   ofstream outf_b;
@@ -383,6 +411,7 @@ void Bit_Checking(const Player& P, MAC_Check<gfp>& MC, int nb,
   vector<gfp> PO(amortize);
   vector<Share<gfp> > f(amortize),h(amortize),a(amortize),b(amortize);
   Share<gfp>  temp;
+  vector<array<Share<gfp>, 3> > batch;
 
   // Do the bits checking
   PO.resize(amortize);
@@ -423,11 +452,14 @@ void Bit_Checking(const Player& P, MAC_Check<gfp>& MC, int nb,
             { throw Offline_Check_Error("Bits"); }
           if (write_output)
             a[i].output(outf_b,false);
+          if (stream)
+            batch.push_back({{a[i]}});
 	}
 
       left_todo-=this_loop;
     }
   outf_b.close();
+  push_checked(P, MC, stream, batch);
 }
 
 
@@ -502,25 +534,31 @@ void Square_Checking(const Player& P,MAC_Check<gf2n_short>& MC,int ns)
 
 template void Triple_Checking(const Player& P, MAC_Check<gfp>& MC, int nm,
         int output_thread, TripleSacriFactory<Share<gfp> >& factory,
-        bool write_output, bool clear, string dir);
+        bool write_output, bool clear, string dir,
+        TupleStream<Share<gfp> >* stream);
 template void Triple_Checking(const Player& P, MAC_Check<gf2n_short>& MC,
         int nm, int output_thread,
         TripleSacriFactory<Share<gf2n_short> >& factory, bool write_output,
-        bool clear, string dir);
+        bool clear, string dir,
+        TupleStream<Share<gf2n_short> >* stream);
 
 template void Square_Checking(const Player& P, MAC_Check<gfp>& MC, int ns,
         int output_thread, TupleSacriFactory<Share<gfp> >& square_factory,
-        bool write_output, bool clear, string dir);
+        bool write_output, bool clear, string dir,
+        TupleStream<Share<gfp> >* stream);
 template void Square_Checking(const Player& P, MAC_Check<gf2n_short>& MC,
         int ns, int output_thread,
         TupleSacriFactory<Share<gf2n_short> >& square_factory,
-        bool write_output, bool clear, string dir);
+        bool write_output, bool clear, string dir,
+        TupleStream<Share<gf2n_short> >* stream);
 
 template void Inverse_Checking(const Player& P, MAC_Check<gfp>& MC, int nr,
         int output_thread, TripleSacriFactory<Share<gfp> >& triple_factory,
         TupleSacriFactory<Share<gfp> >& inverse_factor, bool write_output,
-        bool clear, string dir);
+        bool clear, string dir,
+        TupleStream<Share<gfp> >* stream);
 template void Inverse_Checking(const Player& P, MAC_Check<gf2n_short>& MC, int nr,
         int output_thread, TripleSacriFactory<Share<gf2n_short> >& triple_factory,
         TupleSacriFactory<Share<gf2n_short> >& inverse_factor, bool write_output,
-        bool clear, string dir);
+        bool clear, string dir,
+        TupleStream<Share<gf2n_short> >* stream);
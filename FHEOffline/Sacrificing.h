@@ -9,6 +9,7 @@
 #include "Networking/Player.h"
 #include "Auth/MAC_Check.h"
 #include "Math/Setup.h"
+#include "Tools/SpscRing.h"
 
 template <class T>
 class TripleSacriFactory
@@ -52,22 +53,26 @@ void Triple_Inverse_Checking(const Player& P, MAC_Check<gfp>& MC, int nm,
 template <class T>
 void Triple_Checking(const Player& P, MAC_Check<T>& MC, int nm,
         int output_thread, TripleSacriFactory<Share<T> >& factory,
-        bool write_output = true, bool clear = true, string dir = PREP_DIR);
+        bool write_output = true, bool clear = true, string dir = PREP_DIR,
+        TupleStream<Share<T> >* stream = 0);
 template <class T>
 void Inverse_Checking(const Player& P, MAC_Check<T>& MC, int nr,
         int output_thread, TripleSacriFactory<Share<T> >& triple_factory,
         TupleSacriFactory<Share<T> >& inverse_factor,
-        bool write_output = true, bool clear = true, string dir = PREP_DIR);
+        bool write_output = true, bool clear = true, string dir = PREP_DIR,
+        TupleStream<Share<T> >* stream = 0);
 void Triple_Checking(const Player& P,MAC_Check<gf2n_short>& MC,int nm);
 void Square_Bit_Checking(const Player& P,MAC_Check<gfp>& MC,int ns,int nb);
 template <class T>
 void Square_Checking(const Player& P, MAC_Check<T>& MC, int ns,
         int output_thread, TupleSacriFactory<Share<T> >& factory,
-        bool write_output = true, bool clear = true, string dir = PREP_DIR);
+        bool write_output = true, bool clear = true, string dir = PREP_DIR,
+        TupleStream<Share<T> >* stream = 0);
 void Bit_Checking(const Player& P, MAC_Check<gfp>& MC, int nb,
         int output_thread, TupleSacriFactory<Share<gfp> >& square_factory,
         SingleSacriFactory<Share<gfp> >& bit_factory, bool write_output = true,
-        bool clear = true, string dir = PREP_DIR);
+        bool clear = true, string dir = PREP_DIR,
+        TupleStream<Share<gfp> >* stream = 0);
 void Square_Checking(const Player& P,MAC_Check<gf2n_short>& MC,int ns);
 
 template <class T>
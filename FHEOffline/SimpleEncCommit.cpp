@@ -12,7 +12,8 @@
 
 template<class T, class FD, class S>
 SimpleEncCommitBase<T, FD, S>::SimpleEncCommitBase(const MachineBase& machine) :
-        sec(machine.sec), extra_slack(machine.extra_slack), n_rounds(0)
+        sec(machine.sec), extra_slack(machine.extra_slack), n_rounds(0),
+        pool(machine.pool)
 {
 }
 
@@ -34,8 +35,8 @@ NonInteractiveProofSimpleEncCommit<FD>::NonInteractiveProofSimpleEncCommit(
         P(P), pk(pk), FTD(FTD),
         proof(machine.sec, pk, machine.extra_slack),
 #ifdef LESS_ALLOC_MORE_MEM
-                r(this->sec, this->pk.get_params()), prover(proof, FTD),
-                verifier(proof),
+                r(this->sec, this->pk.get_params()),
+                prover(proof, FTD, this->pool), verifier(proof, this->pool),
 #endif
                 timers(timers)
 {
@@ -88,15 +89,27 @@ void SimpleEncCommitBase<T, FD, S>::generate_ciphertexts(
     PRNG G;
     G.ReSeed();
     prepare_plaintext(G);
-    Random_Coins rc(pk.get_params());
-    for (int i = 0; i < sec; i++)
+    int n_threads = pool.n_workers() + 1;
+    vector<PRNG> Gs(n_threads);
+    vector<Random_Coins> rc(n_threads, pk.get_params());
+    for (int start = 0; start < sec; start += n_threads)
     {
-        r[i].sample(G);
-        rc.assign(r[i]);
-        pk.encrypt(c[i], m[i], rc);
+        int n = min(n_threads, sec - start);
+        for (int l = 0; l < n; l++)
+            Gs[l].SetSeed(G);
+        pool.parallel_for(n, [&](size_t l)
+        {
+            int i = start + l;
+            r[i].sample(Gs[l]);
+            rc[l].assign(r[i]);
+            pk.encrypt(c[i], m[i], rc[l]);
+        });
     }
     timers["Generating"].stop();
-    memory_usage.update("random coins", rc.report_size(CAPACITY));
+    size_t rc_size = 0;
+    for (auto& x : rc)
+        rc_size += x.report_size(CAPACITY);
+    memory_usage.update("random coins", rc_size);
 }
 
 template <class FD>
@@ -110,7 +123,7 @@ size_t NonInteractiveProofSimpleEncCommit<FD>::generate_proof(AddableVector<Ciph
 #endif
     this->generate_ciphertexts(c, m, r, pk, timers);
 #ifndef LESS_ALLOC_MORE_MEM
-    Prover<FD, Plaintext_<FD> > prover(proof, FTD);
+    Prover<FD, Plaintext_<FD> > prover(proof, FTD, this->pool);
 #endif
     size_t prover_memory = prover.NIZKPoK(proof, ciphertexts, cleartexts,
             pk, c, m, r, false, false);
@@ -158,7 +171,7 @@ size_t NonInteractiveProofSimpleEncCommit<FD>::create_more(octetStream& cipherte
         P.pass_around(cleartexts);
         timers["Sending"].stop();
 #ifndef LESS_ALLOC_MORE_MEM
-        Verifier<FD,S> verifier(proof);
+        Verifier<FD,S> verifier(proof, this->pool);
 #endif
         cout << "Checking proof of player " << i << endl;
         timers["Verifying"].start();
@@ -205,7 +218,7 @@ void SummingEncCommit<FD>::create_more()
         Proof::Randomness& r = preimages.r;
 #else
         Proof::Randomness r(this->sec, this->pk.get_params());
-        Prover<FD, Plaintext_<FD> > prover(proof, this->FTD);
+        Prover<FD, Plaintext_<FD> > prover(proof, this->FTD, this->pool);
 #endif
         this->generate_ciphertexts(this->c, this->m, r, pk, timers);
         this->timers["Stage 1 of proof"].start();
@@ -265,7 +278,7 @@ void SummingEncCommit<FD>::create_more()
 #ifdef LESS_ALLOC_MORE_MEM
     Verifier<FD,S>& verifier = this->verifier;
 #else
-    Verifier<FD,S> verifier(proof);
+    Verifier<FD,S> verifier(proof, this->pool);
 #endif
     verifier.Stage_2(e, this->c, ciphertexts, cleartexts,
             this->pk, false, false);
@@ -333,9 +346,8 @@ template <class FD>
 void MultiEncCommit<FD>::add_ciphertexts(vector<Ciphertext>& ciphertexts,
         int offset)
 {
-    for (int i = 0; i < this->sec; i++)
-        generator.multipliers[offset - 1]->multiply_and_add(generator.c.at(i),
-                ciphertexts.at(i), generator.b_mod_q.at(i));
+    generator.multipliers[offset - 1]->multiply_and_add(generator.c,
+            ciphertexts, generator.b_mod_q);
 }
 
 template class SimpleEncCommitBase<gfp, FFT_Data, bigint>;
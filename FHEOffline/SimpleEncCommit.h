@@ -25,6 +25,8 @@ protected:
 
     int n_rounds;
 
+    TaskPool& pool;
+
     void generate_ciphertexts(AddableVector<Ciphertext>& c,
             const vector<Plaintext_<FD> >& m, Proof::Randomness& r,
             const FHE_PK& pk, map<string, Timer>& timers);
@@ -153,7 +155,8 @@ public:
 	proof(this->sec, pk, P.num_players()), pk(pk), FTD(FTD), P(P),
 	thread_num(thread_num),
 #ifdef LESS_ALLOC_MORE_MEM
-            prover(proof, FTD), verifier(proof), preimages(proof.V, this->pk,
+            prover(proof, FTD, this->pool), verifier(proof, this->pool),
+            preimages(proof.V, this->pk,
                 FTD.get_prime(), P.num_players()),
 #endif
             timers(timers) {}
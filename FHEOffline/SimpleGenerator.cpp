@@ -10,6 +10,18 @@
 
 #include "Auth/MAC_Check.hpp"
 
+// all parties stop when the first consumer has finished
+bool GeneratorBase::stream_closed()
+{
+    vector<octetStream> os(P.num_players());
+    os[P.my_num()].store_int(stream->is_closed(), 1);
+    P.Broadcast_Receive(os);
+    for (auto& o : os)
+        if (o.get_int(1))
+            return true;
+    return false;
+}
+
 template <template <class> class T, class FD>
 SimpleGenerator<T,FD>::SimpleGenerator(const Names& N, const PartSetup<FD>& setup,
         const MultiplicativeMachine& machine, int thread_num, Dtype data_type) :
@@ -58,7 +70,8 @@ void SimpleGenerator<T,FD>::run()
     timers["MC init"].start();
     MAC_Check<typename FD::T> MC(setup.alphai);
     timers["MC init"].stop();
-    while (total < machine.nTriplesPerThread or EC.has_left())
+    while (stream ? not stream_closed() :
+            (total < machine.nTriplesPerThread or EC.has_left()))
     {
         producer->run(P, setup.pk, setup.calpha, EC, dd, setup.alphai);
         producer->sacrifice(P, MC);
@@ -71,6 +84,16 @@ void SimpleGenerator<T,FD>::run()
     timers["Networking"] = P.timer;
 }
 
+template <template <class> class T, class FD>
+void SimpleGenerator<T,FD>::set_stream(SpscRingBase* stream)
+{
+    auto tuple_stream = dynamic_cast<TupleStream<Share<typename FD::T>>*>(stream);
+    if (tuple_stream == 0)
+        throw runtime_error("wrong stream type");
+    this->stream = stream;
+    producer->set_stream(tuple_stream);
+}
+
 template <template <class> class T, class FD>
 size_t SimpleGenerator<T,FD>::report_size(ReportType type)
 {
@@ -20,6 +20,9 @@ class GeneratorBase
 {
 protected:
     int thread_num;
+    SpscRingBase* stream;
+
+    bool stream_closed();
 
 public:
     PlainPlayer P;
@@ -28,10 +31,14 @@ public:
 
     map<string, Timer> timers;
 
+    // distinct from the online threads in the same process
     GeneratorBase(int thread_num, const Names& N) :
-        thread_num(thread_num), P(N, thread_num << 16), thread(0), total(0) {}
+        thread_num(thread_num), stream(0),
+        P(N, (5 << 28) + (thread_num << 16)), thread(0), total(0) {}
     virtual ~GeneratorBase() {}
     virtual void run() = 0;
+    // produce for an online phase in the same process until it has finished
+    virtual void set_stream(SpscRingBase* stream) = 0;
     virtual size_t report_size(ReportType type) = 0;
     virtual void report_size(ReportType type, MemoryUsage& res) = 0;
     virtual size_t report_sent() = 0;
@@ -59,6 +66,7 @@ public:
     ~SimpleGenerator();
 
     void run();
+    void set_stream(SpscRingBase* stream);
     size_t report_size(ReportType type);
     void report_size(ReportType type, MemoryUsage& res);
     size_t report_sent() { return P.sent; }
@@ -22,7 +22,8 @@ void* run_generator(void* generator)
 MachineBase::MachineBase() :
         throughput_loop_thread(0),portnum_base(0),
         data_type(DATA_TRIPLE),
-        sec(0), field_size(0), extra_slack(0), produce_inputs(false)
+        sec(0), field_size(0), extra_slack(0), produce_inputs(false),
+        helper_threads(0)
 {
 }
 
@@ -32,6 +33,16 @@ MachineBase::MachineBase(int argc, const char** argv) : MachineBase()
     mult_performance();
 }
 
+MachineBase::MachineBase(Names& N, int nthreads, int field_size,
+        Dtype data_type) :
+        OfflineMachineBase(N), throughput_loop_thread(0), portnum_base(0),
+        data_type(data_type), sec(40), field_size(field_size),
+        extra_slack(0), produce_inputs(false), use_gf2n(false),
+        helper_threads(0)
+{
+    this->nthreads = nthreads;
+}
+
 void MachineBase::parse_options(int argc, const char** argv)
 {
     opt.add(
@@ -79,12 +90,24 @@ void MachineBase::parse_options(int argc, const char** argv)
           "-2", // Flag token.
           "--gf2n" // Flag token.
     );
+    opt.add(
+          "0", // Default.
+          0, // Required?
+          1, // Number of args expected.
+          0, // Delimiter if expecting multiple args.
+          "Additional threads for proofs and ciphertext multiplication, "
+          "shared by all threads (default: 0)", // Help description.
+          "-j", // Flag token.
+          "--helper-threads" // Flag token.
+    );
 
     OfflineMachineBase::parse_options(argc, argv);
     opt.get("-h")->getString(hostname);
     opt.get("-pn")->getInt(portnum_base);
     opt.get("-s")->getInt(sec);
     opt.get("-f")->getInt(field_size);
+    opt.get("-j")->getInt(helper_threads);
+    pool.start_workers(helper_threads);
     use_gf2n = opt.isSet("-2");
     if (use_gf2n)
     {
@@ -185,6 +208,15 @@ SimpleMachine::SimpleMachine(int argc, const char** argv)
                 generators.push_back(new_generator<SimpleEncCommit_, FFT_Data>(i));
 }
 
+SimpleMachine::SimpleMachine(Names& N, int nthreads, int field_size,
+        Dtype data_type) :
+        MultiplicativeMachine(N, nthreads, field_size, data_type)
+{
+    generate_setup(NONINTERACTIVE_SPDZ1_SLACK);
+    for (int i = 0; i < nthreads; i++)
+        generators.push_back(new_generator<SimpleEncCommit_, FFT_Data>(i));
+}
+
 template <template <class FD> class EC, class FD>
 GeneratorBase* SimpleMachine::new_generator(int i)
 {
@@ -302,6 +334,39 @@ void MachineBase::run()
     mult_performance();
 }
 
+void MachineBase::start_streaming(const vector<SpscRingBase*>& streams)
+{
+    assert(streams.size() == generators.size());
+    timer.start();
+    for (int i = 0; i < nthreads; i++)
+    {
+        generators[i]->set_stream(streams[i]);
+        pthread_create(&(generators[i]->thread), 0, run_generator,
+                generators[i]);
+    }
+}
+
+void MachineBase::stop_streaming()
+{
+    long long total = 0;
+    for (int i = 0; i < nthreads; i++)
+    {
+        pthread_join(generators[i]->thread, 0);
+        total += generators[i]->total;
+        delete generators[i];
+    }
+    generators.clear();
+    timer.stop();
+    cerr << "Produced " << total << " " << item_type() << " in "
+            << timer.elapsed() << " seconds" << endl;
+}
+
+void MachineBase::init_online_setup(int lg2)
+{
+    gfp::init_field(get_prime());
+    gf2n::init_field(lg2);
+}
+
 void MachineBase::throughput_loop()
 {
     deque<size_t> totals;
@@ -11,6 +11,7 @@
 #include "Networking/Player.h"
 #include "FHEOffline/SimpleGenerator.h"
 #include "Tools/OfflineMachineBase.h"
+#include "Tools/TaskPool.h"
 
 class MachineBase : public OfflineMachineBase
 {
@@ -28,11 +29,26 @@ public:
     int extra_slack;
     bool produce_inputs;
     bool use_gf2n;
+    int helper_threads;
+
+    // helper threads, shared by all threads
+    mutable TaskPool pool;
 
     MachineBase();
     MachineBase(int argc, const char** argv);
+    MachineBase(Names& N, int nthreads, int field_size, Dtype data_type);
+    virtual ~MachineBase() {}
     void run();
 
+    // feed an online phase in the same process, one stream per thread
+    void start_streaming(const vector<SpscRingBase*>& streams);
+    void stop_streaming();
+
+    // fields for an online phase in the same process
+    void init_online_setup(int lg2);
+    virtual bigint get_prime() = 0;
+    virtual gfp get_alphapi() = 0;
+
     void parse_options(int argc, const char** argv);
 
     string item_type();
@@ -59,9 +75,16 @@ protected:
     void fake_keys(int slack);
 
 public:
+    MultiplicativeMachine() {}
+    MultiplicativeMachine(Names& N, int nthreads, int field_size,
+            Dtype data_type) :
+            MachineBase(N, nthreads, field_size, data_type) {}
     virtual ~MultiplicativeMachine() {}
 
     virtual int get_covert() const { return 0; }
+
+    bigint get_prime() { return setup.FTD.get_prime(); }
+    gfp get_alphapi() { return setup.alphapi; }
 };
 
 class SimpleMachine : public MultiplicativeMachine
@@ -71,6 +94,7 @@ class SimpleMachine : public MultiplicativeMachine
 
 public:
     SimpleMachine(int argc, const char** argv);
+    SimpleMachine(Names& N, int nthreads, int field_size, Dtype data_type);
 };
 
 #endif /* FHEOFFLINE_SIMPLEMACHINE_H_ */
@@ -1,13 +1,18 @@
 #include "Verifier.h"
 
 template <class FD, class S>
-Verifier<FD,S>::Verifier(const Proof& proof) : P(proof)
+Verifier<FD,S>::Verifier(const Proof& proof, TaskPool& pool) :
+    pool(pool), n_threads(pool.n_workers() + 1), z(n_threads), t(n_threads),
+    P(proof)
 {
 #ifdef LESS_ALLOC_MORE_MEM
-  z.resize(proof.phim);
-  z.allocate_slots(bigint(1) << proof.B_plain_length);
-  t.resize(3, proof.phim);
-  t.allocate_slots(bigint(1) << proof.B_rand_length);
+  for (int i = 0; i < n_threads; i++)
+    {
+      z[i].resize(proof.phim);
+      z[i].allocate_slots(bigint(1) << proof.B_plain_length);
+      t[i].resize(3, proof.phim);
+      t[i].allocate_slots(bigint(1) << proof.B_rand_length);
+    }
 #endif
 }
 
@@ -44,59 +49,74 @@ void Verifier<FD,S>::Stage_2(const vector<int>& e,
                           octetStream& cleartexts,
                           const FHE_PK& pk,bool Diag,bool binary)
 {
-  unsigned int i,k,V=P.V;
+  unsigned int V=P.V;
 
   c.unpack(ciphertexts, pk);
   if (c.size() != P.sec)
     throw length_error("number of received ciphertexts incorrect");
 
   // Now check the encryptions are correct
-  int ee;
-  Ciphertext d1(pk.get_params()), d2(pk.get_params());
-  Random_Coins rc(pk.get_params());
+  AddableVector<Ciphertext> d1(n_threads, pk.get_params()),
+      d2(n_threads, pk.get_params());
+  vector<Random_Coins> rc(n_threads, pk.get_params());
   ciphertexts.get(V);
   if (V != P.V)
     throw length_error("number of received commitments incorrect");
   cleartexts.get(V);
   if (V != P.V)
     throw length_error("number of received cleartexts incorrect");
-  for (i=0; i<V; i++)
-    {
-      z.unpack(cleartexts);
-      t.unpack(cleartexts);
-      if (!P.check_bounds(z, t, i))
-        throw runtime_error("preimage out of bounds");
-      d1.unpack(ciphertexts);
-      for (k=0; k<P.sec; k++)
-        { int jj=(i+1)-(k+1);
-          if (jj<0 || jj>= (int) P.sec) { ee=0; }
-          else                          { ee=e[jj]; }
-          if (ee!=0)
-            { add(d1,d1,c.at(jj)); }
-        }
-      rc.assign(t[0], t[1], t[2]);
-      pk.encrypt(d2,z,rc);
-      if (!(d1 == d2))
-        { cout << "Fail Check 6 " << i << endl; 
-          throw runtime_error("ciphertexts don't match");
-        }
-    }
-
-  // Now check decoding z[i]
-  for (i=0; i<V; i++)
+  for (unsigned int start=0; start<V; start+=n_threads)
     {
-      if (!Check_Decoding(z,Diag))
-         { cout << "\tCheck : " << i << endl; 
-           throw runtime_error("cleartext isn't diagonal");
-         }
-      if (binary && !z.is_binary())
+      int n=min(n_threads, int(V-start));
+      for (int l=0; l<n; l++)
         {
-          cout << "Not binary " << i << endl;
-          throw runtime_error("cleartext isn't binary");
+          z[l].unpack(cleartexts);
+          t[l].unpack(cleartexts);
+          d1[l].unpack(ciphertexts);
         }
+      pool.parallel_for(n, [&](size_t l)
+        {
+          unsigned int i=start+l;
+          int ee;
+          if (!P.check_bounds(z[l], t[l], i))
+            throw runtime_error("preimage out of bounds");
+          for (unsigned int k=0; k<P.sec; k++)
+            { int jj=(i+1)-(k+1);
+              if (jj<0 || jj>= (int) P.sec) { ee=0; }
+              else                          { ee=e[jj]; }
+              if (ee!=0)
+                { add(d1[l],d1[l],c.at(jj)); }
+            }
+          rc[l].assign(t[l][0], t[l][1], t[l][2]);
+          pk.encrypt(d2[l],z[l],rc[l]);
+          if (!(d1[l] == d2[l]))
+            { cout << "Fail Check 6 " << i << endl;
+              throw runtime_error("ciphertexts don't match");
+            }
+
+          // Now check decoding z[i]
+          if (!Check_Decoding(z[l],Diag))
+            { cout << "\tCheck : " << i << endl;
+              throw runtime_error("cleartext isn't diagonal");
+            }
+          if (binary && !z[l].is_binary())
+            {
+              cout << "Not binary " << i << endl;
+              throw runtime_error("cleartext isn't binary");
+            }
+        });
     }
 }
 
+template <class FD, class S>
+size_t Verifier<FD,S>::report_size(ReportType type)
+{
+  size_t res = 0;
+  for (int i = 0; i < n_threads; i++)
+    res += z[i].report_size(type) + t[i].report_size(type);
+  return res;
+}
+
   
 
 /* This is the non-interactive version using the ROM
@@ -2,18 +2,24 @@
 #define _Verifier
 
 #include "Proof.h"
+#include "Tools/TaskPool.h"
 
 /* Defines the Verifier */
 template <class FD, class S>
 class Verifier
 {
-  AddableVector<S> z;
-  AddableMatrix<S> t;
+  /* Commitments are checked for as many at once
+     as there are threads */
+  TaskPool& pool;
+  int n_threads;
+
+  vector< AddableVector<S> > z;
+  vector< AddableMatrix<S> > t;
 
   const Proof& P;
 
 public:
-  Verifier(const Proof& proof);
+  Verifier(const Proof& proof, TaskPool& pool);
 
   void Stage_2(const vector<int>& e,
       AddableVector<Ciphertext>& c, octetStream& ciphertexts,
@@ -26,7 +32,7 @@ public:
   void NIZKPoK(AddableVector<Ciphertext>& c,octetStream& ciphertexts,octetStream& cleartexts,
                const FHE_PK& pk,bool Diag,bool binary=false);
 
-  size_t report_size(ReportType type) { return z.report_size(type) + t.report_size(type); }
+  size_t report_size(ReportType type);
 };
 
 #endif
@@ -0,0 +1,289 @@
+/*
+ * MaliciousRepPrep.cpp
+ *
+ */
+
+#include "MaliciousRepPrep.h"
+#include "MaliciousRepThread.h"
+#include "Auth/MaliciousRepMC.h"
+#include "Auth/Subroutines.h"
+#include "Networking/CryptoPlayer.h"
+#include "Exceptions/Exceptions.h"
+
+#include "Processor/Data_Files.hpp"
+#include "Processor/Replicated.hpp"
+
+namespace GC
+{
+
+MaliciousRepPrep::MaliciousRepPrep(DataPositions& usage,
+        MaliciousRepThread& thread) :
+        Preprocessing<T>(usage), thread(thread), started(false),
+        stopping(false), buffer_size(1 << 14), n_batches(2)
+{
+}
+
+MaliciousRepPrep::~MaliciousRepPrep()
+{
+    if (started)
+    {
+        signal.lock();
+        stopping = true;
+        signal.broadcast();
+        signal.unlock();
+        pthread_join(pthread, 0);
+    }
+}
+
+void MaliciousRepPrep::start()
+{
+    started = true;
+    pthread_create(&pthread, 0, run_thread, this);
+}
+
+void* MaliciousRepPrep::run_thread(void* prep)
+{
+    ((MaliciousRepPrep*) prep)->run();
+    return 0;
+}
+
+void MaliciousRepPrep::run()
+{
+    try
+    {
+        // same layout as AsyncPrep
+        int id = (4 << 28) + ((T::field_type() + 1) << 24)
+                + (thread.thread_num << 16);
+        Player* P;
+        if (thread.machine.use_encryption)
+            P = new CryptoPlayer(thread.N, id);
+        else
+            P = new PlainPlayer(thread.N, id);
+
+        {
+            ReplicatedBase protocol(*P);
+            T::MC* MC = thread.new_mc();
+            while (wait_for_demand(*P))
+            {
+                vector<Triple> batch;
+                generate(batch, *P, protocol, *MC);
+                signal.lock();
+                queue.push_back({});
+                queue.back().swap(batch);
+                signal.broadcast();
+                signal.unlock();
+            }
+            MC->Check(*P);
+            delete MC;
+        }
+        delete P;
+    }
+    catch (exception& e)
+    {
+        signal.lock();
+        error = e.what();
+        signal.broadcast();
+        signal.unlock();
+    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    OPENSSL_thread_stop();
+#endif
+}
+
+bool MaliciousRepPrep::wait_for_demand(Player& P)
+{
+    signal.lock();
+    while (not stopping and queue.size() >= size_t(n_batches))
+        signal.wait();
+    bool stop = stopping;
+    signal.unlock();
+
+    // all parties stop as soon as one does
+    vector<octetStream> os(P.num_players());
+    os[P.my_num()].store_int(stop, 1);
+    P.Broadcast_Receive(os, true);
+    for (auto& o : os)
+        if (o.get_int(1))
+            return false;
+    return true;
+}
+
+template<class V>
+inline V rotate(const V& x, int n)
+{
+    // masking also removes the sign extension of BitVec
+    return n ? V(x << n) ^ V(x >> (V::n_bits - n)).mask(n) : x;
+}
+
+void MaliciousRepPrep::generate(vector<Triple>& output, Player& P,
+        ReplicatedBase& protocol, T::MC& MC)
+{
+    int n_tuples = buffer_size * BUCKET_SIZE + N_OPENED;
+    vector<Triple> tuples(n_tuples);
+
+    // semi-honest triples like in ReplicatedSecret::prepare_and()
+    vector<octetStream> os(2);
+    for (auto& tuple : tuples)
+    {
+        for (int k = 0; k < 2; k++)
+            for (int i = 0; i < 2; i++)
+                tuple[k][i].randomize(protocol.shared_prngs[i]);
+        auto& a = tuple[0];
+        auto& b = tuple[1];
+        T::clear tmp[2];
+        for (int i = 0; i < 2; i++)
+            tmp[i].randomize(protocol.shared_prngs[i]);
+        tuple[2][0] = a[0] * b.sum() + a[1] * b[0] + tmp[0] - tmp[1];
+        tuple[2][0].pack(os[0]);
+    }
+    P.send_relative(os);
+    P.receive_relative(os);
+    for (auto& tuple : tuples)
+        tuple[2][1].unpack(os[1]);
+
+    // shuffle with joint randomness only known after the multiplication,
+    // rotating the bits within words to mix positions as well
+    octet seed[SEED_SIZE];
+    Create_Random_Seed(seed, P, SEED_SIZE);
+    PRNG G;
+    G.SetSeed(seed);
+    for (int i = n_tuples - 1; i > 0; i--)
+        swap(tuples[i], tuples[G.get_uint(i + 1)]);
+    for (auto& tuple : tuples)
+    {
+        int n = G.get_uint(T::clear::n_bits);
+        for (auto& x : tuple)
+            for (int i = 0; i < 2; i++)
+                x[i] = rotate(x[i], n);
+    }
+
+    vector<T> shares;
+    vector<T::clear> opened;
+
+    // cut
+    for (int i = 0; i < N_OPENED; i++)
+        for (auto& x : tuples[i])
+            shares.push_back(x);
+    MC.POpen_Begin(opened, shares, P);
+    MC.POpen_End(opened, shares, P);
+    for (int i = 0; i < N_OPENED; i++)
+        if (opened[3 * i + 2] != opened[3 * i] * opened[3 * i + 1])
+            throw Offline_Check_Error("binary triple");
+
+    // check the first triple in every bucket against the others
+    shares.clear();
+    for (int i = 0; i < buffer_size; i++)
+    {
+        auto bucket = tuples.begin() + N_OPENED + i * BUCKET_SIZE;
+        for (int j = 1; j < BUCKET_SIZE; j++)
+            for (int k = 0; k < 2; k++)
+                shares.push_back(bucket[0][k] - bucket[j][k]);
+    }
+    MC.POpen_Begin(opened, shares, P);
+    MC.POpen_End(opened, shares, P);
+
+    auto it = opened.begin();
+    vector<T::clear> products;
+    shares.clear();
+    for (int i = 0; i < buffer_size; i++)
+    {
+        auto bucket = tuples.begin() + N_OPENED + i * BUCKET_SIZE;
+        for (int j = 1; j < BUCKET_SIZE; j++)
+        {
+            T::clear rho = *it++;
+            T::clear sigma = *it++;
+            // x * y - z for x = a + rho and y = b + sigma
+            shares.push_back(
+                    bucket[j][2] + (bucket[j][0] & sigma)
+                            + (bucket[j][1] & rho) - bucket[0][2]);
+            products.push_back(rho * sigma);
+        }
+    }
+    MC.POpen_Begin(opened, shares, P);
+    MC.POpen_End(opened, shares, P);
+    for (size_t i = 0; i < opened.size(); i++)
+        if (opened[i] != products[i])
+            throw Offline_Check_Error("binary triple");
+
+    MC.Check(P);
+
+    output.clear();
+    output.reserve(buffer_size);
+    for (int i = 0; i < buffer_size; i++)
+        output.push_back(tuples[N_OPENED + i * BUCKET_SIZE]);
+}
+
+void MaliciousRepPrep::fetch()
+{
+    if (not started)
+        start();
+
+    signal.lock();
+    while (queue.empty() and error.empty())
+        signal.wait();
+    if (not error.empty())
+    {
+        signal.unlock();
+        throw runtime_error("binary triple generation failed: " + error);
+    }
+    triples.swap(queue.front());
+    queue.pop_front();
+    signal.broadcast();
+    signal.unlock();
+}
+
+void MaliciousRepPrep::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
+{
+    if (dtype != DATA_TRIPLE)
+        throw not_implemented();
+    if (triples.empty())
+        fetch();
+    a = triples.back()[0];
+    b = triples.back()[1];
+    c = triples.back()[2];
+    triples.pop_back();
+}
+
+void MaliciousRepPrep::get_two_no_count(Dtype dtype, T& a, T& b)
+{
+    (void) dtype, (void) a, (void) b;
+    throw not_implemented();
+}
+
+void MaliciousRepPrep::get_one_no_count(Dtype dtype, T& a)
+{
+    if (dtype != DATA_BIT)
+        throw not_implemented();
+    // the first factor of a triple is a random sharing of all bits
+    if (bits.empty())
+    {
+        if (triples.empty())
+            fetch();
+        auto& x = triples.back()[0];
+        for (int i = 0; i < T::clear::n_bits; i++)
+            for (int j = 0; j < 2; j++)
+                bits.push_back(T::clear(x[j] >> i).mask(1));
+        triples.pop_back();
+    }
+    for (int j = 1; j >= 0; j--)
+    {
+        a[j] = bits.back();
+        bits.pop_back();
+    }
+}
+
+void MaliciousRepPrep::get_input_no_count(T& a, T::open_type& x, int i)
+{
+    (void) a, (void) x, (void) i;
+    throw not_implemented();
+}
+
+void MaliciousRepPrep::get_no_count(vector<T>& S, DataTag tag,
+        const vector<int>& regs, int vector_size)
+{
+    (void) S, (void) tag, (void) regs, (void) vector_size;
+    throw not_implemented();
+}
+
+} /* namespace GC */
@@ -0,0 +1,85 @@
+/*
+ * MaliciousRepPrep.h
+ *
+ */
+
+#ifndef GC_MALICIOUSREPPREP_H_
+#define GC_MALICIOUSREPPREP_H_
+
+#include "MaliciousRepSecret.h"
+#include "Processor/Data_Files.h"
+#include "Tools/Signal.h"
+
+#include <deque>
+#include <array>
+
+namespace GC
+{
+
+class MaliciousRepThread;
+
+/*
+ * Malicious triples for the binary replicated VM by cut-and-choose
+ * on word-wise semi-honest triples (Furukawa et al., Eurocrypt 2017):
+ * some triples are opened, and the rest are shuffled into buckets of
+ * which the first triple is checked against the others. Generation
+ * runs in a background thread with its own player, and every round
+ * the parties agree on whether to produce or stop.
+ */
+class MaliciousRepPrep : public Preprocessing<MaliciousRepSecret>
+{
+    typedef MaliciousRepSecret T;
+    typedef array<T, 3> Triple;
+
+    // The shuffle permutes whole registers, so an adversary corrupting
+    // all bits of BUCKET_SIZE registers succeeds if they end up in the
+    // same bucket, which happens with probability about
+    // BUCKET_SIZE! / (BUCKET_SIZE^BUCKET_SIZE * buffer_size^(BUCKET_SIZE - 1)),
+    // that is, 3 / (32 * 2^42) < 2^-45 for the default of 2^14 registers.
+    static const int BUCKET_SIZE = 4;
+    static const int N_OPENED = 3;
+
+    MaliciousRepThread& thread;
+
+    pthread_t pthread;
+    bool started;
+
+    Signal signal;
+    bool stopping;
+    string error;
+
+    deque<vector<Triple>> queue;
+    vector<Triple> triples;
+    vector<T::clear> bits;
+
+    static void* run_thread(void* prep);
+
+    void start();
+    void run();
+    bool wait_for_demand(Player& P);
+    void generate(vector<Triple>& output, Player& P, ReplicatedBase& protocol,
+            T::MC& MC);
+    void fetch();
+
+public:
+    // output triples (of a register each) per batch
+    int buffer_size;
+    // number of batches to keep ready in addition to the one in use
+    int n_batches;
+
+    MaliciousRepPrep(DataPositions& usage, MaliciousRepThread& thread);
+    ~MaliciousRepPrep();
+
+    void set_protocol(ReplicatedBase& protocol) { (void) protocol; }
+
+    void get_three_no_count(Dtype dtype, T& a, T& b, T& c);
+    void get_two_no_count(Dtype dtype, T& a, T& b);
+    void get_one_no_count(Dtype dtype, T& a);
+    void get_input_no_count(T& a, T::open_type& x, int i);
+    void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs,
+            int vector_size);
+};
+
+} /* namespace GC */
+
+#endif /* GC_MALICIOUSREPPREP_H_ */
@@ -5,6 +5,8 @@
 
 #include "Auth/MaliciousRepMC.h"
 #include "MaliciousRepThread.h"
+#include "MaliciousRepPrep.h"
+#include "ThreadMaster.h"
 #include "Math/Setup.h"
 
 #include "Auth/MaliciousRepMC.hpp"
@@ -15,13 +17,28 @@ namespace GC
 
 thread_local MaliciousRepThread* MaliciousRepThread::singleton = 0;
 
+Preprocessing<MaliciousRepSecret>& new_prep(DataPositions& usage,
+        MaliciousRepThread& thread, OnlineOptions& opts)
+{
+    if (opts.live_prep)
+        return *new MaliciousRepPrep(usage, thread);
+    else
+        return *new Sub_Data_Files<MaliciousRepSecret>(thread.N.my_num(),
+                thread.N.num_players(),
+                get_prep_dir(thread.N.num_players(), 128,
+                        gf2n::default_degree()), usage, thread.thread_num);
+}
+
 MaliciousRepThread::MaliciousRepThread(int i,
         ThreadMaster<MaliciousRepSecret>& master) :
-        Thread<MaliciousRepSecret>(i, master), DataF(N.my_num(),
-                N.num_players(),
-                get_prep_dir(N.num_players(), 128, gf2n::default_degree()),
-                usage, i)
+        Thread<MaliciousRepSecret>(i, master),
+        DataF(new_prep(usage, *this, master.opts))
+{
+}
+
+MaliciousRepThread::~MaliciousRepThread()
 {
+    delete &DataF;
 }
 
 MaliciousRepMC<MaliciousRepSecret>* MaliciousRepThread::new_mc()
@@ -42,8 +59,11 @@ void MaliciousRepThread::pre_run()
 void MaliciousRepThread::post_run()
 {
 #ifndef INSECURE
-    cerr << "Removing used pre-processed data" << endl;
-    DataF.prune();
+    if (not master.opts.live_prep)
+    {
+        cerr << "Removing used pre-processed data" << endl;
+        DataF.prune();
+    }
 #endif
 }
 
@@ -51,42 +71,54 @@ void MaliciousRepThread::and_(Processor<MaliciousRepSecret>& processor,
         const vector<int>& args, bool repeat)
 {
     assert(P->num_players() == 3);
-    os.resize(2);
-    for (auto& o : os)
-        o.reset_write_head();
     processor.check_args(args, 4);
-    shares.clear();
-    triples.clear();
-    for (size_t i = 0; i < args.size(); i += 4)
+    // triples in the same order as without chunks
+    triples.resize(args.size() / 4);
+    for (auto& triple : triples)
+        DataF.get(DATA_TRIPLE, triple.data());
+    run_chunks(args.size() / 4,
+            [&](int chunk, size_t begin, size_t end)
+            {
+                and_(processor, args, begin, end, repeat, *chunk_Ps[chunk],
+                        *chunk_MCs[chunk]);
+            });
+}
+
+void MaliciousRepThread::and_(Processor<MaliciousRepSecret>& processor,
+        const vector<int>& args, size_t begin, size_t end, bool repeat,
+        Player& P, MaliciousRepSecret::MC& MC)
+{
+    vector<MaliciousRepSecret> shares;
+    vector<MaliciousRepSecret::clear> opened;
+    for (size_t i = begin; i < end; i++)
     {
-        int n_bits = args[i];
-        int left = args[i + 2];
-        int right = args[i + 3];
-        triples.push_back({{0}});
-        DataF.get(DATA_TRIPLE, triples.back().data());
-        shares.push_back((processor.S[left] - triples.back()[0]).mask(n_bits));
+        int n_bits = args[4 * i];
+        MaliciousRepSecret::check_length(n_bits);
+        int left = args[4 * i + 2];
+        int right = args[4 * i + 3];
+        shares.push_back((processor.S[left] - triples[i][0]).mask(n_bits));
         MaliciousRepSecret y_ext;
         if (repeat)
             y_ext = processor.S[right].extend_bit();
         else
             y_ext = processor.S[right];
-        shares.push_back((y_ext - triples.back()[1]).mask(n_bits));
+        shares.push_back((y_ext - triples[i][1]).mask(n_bits));
     }
 
-    MC->POpen_Begin(opened, shares, *P);
-    MC->POpen_End(opened, shares, *P);
+    MC.POpen_Begin(opened, shares, P);
+    MC.POpen_End(opened, shares, P);
     auto it = opened.begin();
 
-    for (size_t i = 0; i < args.size(); i += 4)
+    for (size_t i = begin; i < end; i++)
     {
-        int n_bits = args[i];
-        int out = args[i + 1];
-        MaliciousRepSecret tmp = triples[i / 4][2];
-        BitVec masked[2];
+        int n_bits = args[4 * i];
+        int out = args[4 * i + 1];
+        MaliciousRepSecret tmp = triples[i][2];
+        MaliciousRepSecret::clear masked[2];
         for (int k = 0; k < 2; k++)
         {
             masked[k] = *it++;
-            tmp += triples[i / 4][1 - k] & masked[k];
+            tmp += triples[i][1 - k] & masked[k];
         }
         processor.S[out] = (tmp + (masked[0] & masked[1])).mask(n_bits);
     }
@@ -19,18 +19,20 @@ class MaliciousRepThread : public Thread<MaliciousRepSecret>
 {
     static thread_local MaliciousRepThread* singleton;
 
-    vector<MaliciousRepSecret> shares;
-    vector<BitVec> opened;
     vector<array<MaliciousRepSecret, 3>> triples;
 
+    void and_(Processor<MaliciousRepSecret>& processor,
+            const vector<int>& args, size_t begin, size_t end, bool repeat,
+            Player& P, MaliciousRepSecret::MC& MC);
+
 public:
     static MaliciousRepThread& s();
 
     DataPositions usage;
-    Sub_Data_Files<MaliciousRepSecret> DataF;
+    Preprocessing<MaliciousRepSecret>& DataF;
 
     MaliciousRepThread(int i, ThreadMaster<MaliciousRepSecret>& master);
-    virtual ~MaliciousRepThread() {}
+    virtual ~MaliciousRepThread();
 
     MaliciousRepSecret::MC* new_mc();
 
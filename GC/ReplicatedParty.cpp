@@ -62,6 +62,7 @@ ReplicatedParty<T>::ReplicatedParty(int argc, const char** argv) :
     opt.get("-h")->getString(hostname);
     this->machine.use_encryption = not opt.get("-u")->isSet;
     this->machine.more_comm_less_comp = opt.get("-c")->isSet;
+    this->work_stealing = true;
 
     T::out.activate(my_num == 0 or online_opts.interactive);
 
@@ -10,6 +10,7 @@
 #include "MaliciousRepThread.h"
 #include "Thread.h"
 #include "square64.h"
+#include "WideSquare.h"
 
 #include "Math/Share.h"
 
@@ -142,36 +143,36 @@ void ReplicatedSecret<U>::prepare_input(vector<octetStream>& os, long input, int
     randomize_to_sum(input, secure_prng);
     *this &= get_mask(n_bits);
     for (int i = 0; i < 2; i++)
-        BitVec(get_mask(n_bits) & (*this)[i]).pack(os[i], n_bits);
+        (*this)[i].pack(os[i], n_bits);
 }
 
 template<class U>
 void ReplicatedSecret<U>::finalize_input(Thread<U>& party, octetStream& o, int from, int n_bits)
 {
     int j = party.P->get_offset(from) == 2;
-    (*this)[j] = BitVec::unpack_new(o, n_bits);
+    (*this)[j] = clear::unpack_new(o, n_bits);
     (*this)[1 - j] = 0;
 }
 
 template<>
 inline void ReplicatedSecret<SemiHonestRepSecret>::prepare_and(vector<octetStream>& os, int n,
         const ReplicatedSecret<SemiHonestRepSecret>& x, const ReplicatedSecret<SemiHonestRepSecret>& y,
-        Thread<SemiHonestRepSecret>& party, bool repeat)
+        ReplicatedBase& protocol, bool repeat)
 {
+    check_length(n);
     ReplicatedSecret y_ext;
     if (repeat)
         y_ext = y.extend_bit();
     else
         y_ext = y;
     auto add_share = x[0] * y_ext.sum() + x[1] * y_ext[0];
-    BitVec tmp[2];
+    clear tmp[2];
     for (int i = 0; i < 2; i++)
-        tmp[i].randomize(party.protocol->shared_prngs[i]);
+        tmp[i].randomize(protocol.shared_prngs[i]);
     add_share += tmp[0] - tmp[1];
     (*this)[0] = add_share;
-    BitVec mask = get_mask(n);
-    *this &= mask;
-    BitVec(mask & (*this)[0]).pack(os[0], n);
+    *this = mask(n);
+    (*this)[0].pack(os[0], n);
 }
 
 template<>
@@ -192,7 +193,7 @@ void ReplicatedSecret<SemiHonestRepSecret>::andrs(int n,
     os.resize(2);
     for (auto& o : os)
         o.reset_write_head();
-    prepare_and(os, n, x, y, party, true);
+    prepare_and(os, n, x, y, *party.protocol, true);
     party.P->send_relative(os);
     party.P->receive_relative(os);
     finalize_andrs(os, n);
@@ -218,25 +219,36 @@ void ReplicatedSecret<MaliciousRepSecret>::and_(int n,
     throw runtime_error("use static method");
 }
 
+template<>
+void ReplicatedSecret<SemiHonestRepSecret>::and_(Processor<SemiHonestRepSecret>& processor,
+        const vector<int>& args, size_t begin, size_t end, bool repeat,
+        Player& P, ReplicatedBase& protocol)
+{
+    vector<octetStream> os(2);
+    for (size_t i = begin; i < end; i += 4)
+        processor.S[args[i + 1]].prepare_and(os, args[i],
+                processor.S[args[i + 2]], processor.S[args[i + 3]],
+                protocol, repeat);
+    P.send_relative(os);
+    P.receive_relative(os);
+    for (size_t i = begin; i < end; i += 4)
+        processor.S[args[i + 1]].finalize_andrs(os, args[i]);
+}
+
 template<>
 void ReplicatedSecret<SemiHonestRepSecret>::and_(Processor<SemiHonestRepSecret>& processor,
         const vector<int>& args, bool repeat)
 {
     auto& party = Thread<SemiHonestRepSecret>::s();
     assert(party.P->num_players() == 3);
-    vector<octetStream>& os = party.os;
-    os.resize(2);
-    for (auto& o : os)
-        o.reset_write_head();
     processor.check_args(args, 4);
-    for (size_t i = 0; i < args.size(); i += 4)
-        processor.S[args[i + 1]].prepare_and(os, args[i],
-                processor.S[args[i + 2]], processor.S[args[i + 3]],
-                party, repeat);
-    party.P->send_relative(os);
-    party.P->receive_relative(os);
-    for (size_t i = 0; i < args.size(); i += 4)
-        processor.S[args[i + 1]].finalize_andrs(os, args[i]);
+    party.run_chunks(args.size() / 4,
+            [&](int chunk, size_t begin, size_t end)
+            {
+                and_(processor, args, 4 * begin, 4 * end, repeat,
+                        *party.chunk_Ps[chunk],
+                        *party.chunk_protocols[chunk]);
+            });
 }
 
 template<>
@@ -247,19 +259,44 @@ void ReplicatedSecret<MaliciousRepSecret>::and_(
     MaliciousRepThread::s().and_(processor, args, repeat);
 }
 
+inline void transpose(vector<BitVec>& rows, int n_rows, int n_cols)
+{
+    square64 square;
+    for (int i = 0; i < n_rows; i++)
+        square.rows[i] = rows[i].get();
+    square.transpose(n_rows, n_cols);
+    rows.resize(n_cols);
+    for (int i = 0; i < n_cols; i++)
+        rows[i] = square.rows[i];
+}
+
+template<int L>
+void transpose(vector<WideBitVec<L>>& rows, int n_rows, int n_cols)
+{
+    WideSquare<L> square;
+    for (int i = 0; i < n_rows; i++)
+        square.set_row(i, rows[i]);
+    square.transpose(n_rows, n_cols);
+    rows.resize(n_cols);
+    for (int i = 0; i < n_cols; i++)
+        rows[i] = square.get_row(i);
+}
+
 template<class U>
 void ReplicatedSecret<U>::trans(Processor<U>& processor,
         int n_outputs, const vector<int>& args)
 {
     assert(length == 2);
+    int n_inputs = args.size() - n_outputs;
+    check_length(max(n_inputs, n_outputs));
     for (int k = 0; k < 2; k++)
     {
-        square64 square;
+        vector<clear> rows;
         for (size_t i = n_outputs; i < args.size(); i++)
-            square.rows[i - n_outputs] = processor.S[args[i]][k].get();
-        square.transpose(args.size() - n_outputs, n_outputs);
+            rows.push_back(processor.S[args[i]][k]);
+        transpose(rows, n_inputs, n_outputs);
         for (int i = 0; i < n_outputs; i++)
-            processor.S[args[i]][k] = square.rows[i];
+            processor.S[args[i]][k] = rows[i];
     }
 }
 
@@ -268,11 +305,11 @@ void ReplicatedSecret<U>::reveal(size_t n_bits, Clear& x)
 {
     (void) n_bits;
     ReplicatedSecret share = *this;
-    vector<BitVec> opened;
+    vector<clear> opened;
     auto& party = ReplicatedParty<U>::s();
     party.MC->POpen_Begin(opened, {share}, *party.P);
     party.MC->POpen_End(opened, {share}, *party.P);
-    x = IntBase(opened[0]);
+    x = opened[0].get();
 }
 
 template<>
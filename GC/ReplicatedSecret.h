@@ -14,8 +14,10 @@ using namespace std;
 #include "GC/Access.h"
 #include "Math/FixedVec.h"
 #include "Math/BitVec.h"
+#include "Math/WideBitVec.h"
 #include "Tools/SwitchableOutput.h"
 #include "Processor/Replicated.h"
+#include "config.h"
 
 namespace GC
 {
@@ -26,16 +28,22 @@ class Processor;
 template <class T>
 class Thread;
 
+#if REPLICATED_BITS == 64
+typedef BitVec ReplicatedWord;
+#else
+typedef WideBitVec<REPLICATED_BITS> ReplicatedWord;
+#endif
+
 template<class U>
-class ReplicatedSecret : public FixedVec<BitVec, 2>
+class ReplicatedSecret : public FixedVec<ReplicatedWord, 2>
 {
-    typedef FixedVec<BitVec, 2> super;
+    typedef FixedVec<ReplicatedWord, 2> super;
 
 public:
-    typedef BitVec clear;
-    typedef BitVec open_type;
-    typedef BitVec mac_type;
-    typedef BitVec mac_key_type;
+    typedef ReplicatedWord clear;
+    typedef ReplicatedWord open_type;
+    typedef ReplicatedWord mac_type;
+    typedef ReplicatedWord mac_key_type;
 
     typedef ReplicatedBase Protocol;
 
@@ -56,6 +64,9 @@ public:
     static void ands(Processor<U>& processor, const vector<int>& args)
     { and_(processor, args, false); }
     static void and_(Processor<U>& processor, const vector<int>& args, bool repeat);
+    static void and_(Processor<U>& processor, const vector<int>& args,
+            size_t begin, size_t end, bool repeat, Player& P,
+            ReplicatedBase& protocol);
     static void inputb(Processor<U>& processor, const vector<int>& args);
 
     static void trans(Processor<U>& processor, int n_outputs,
@@ -63,7 +74,13 @@ public:
 
     static void convcbit(Integer& dest, const Clear& source) { dest = source; }
 
-    static BitVec get_mask(int n) { return n >= 64 ? -1 : ((1L << n) - 1); }
+    static clear get_mask(int n) { return clear(-1).mask(n); }
+    static void check_length(int n)
+    {
+        if (n > default_length)
+            throw runtime_error("registers only have " + to_string(default_length)
+                    + " bits, recompile with smaller vectors");
+    }
 
     static U input(int from, Processor<U>& processor, int n_bits);
     void prepare_input(vector<octetStream>& os, long input, int n_bits, PRNG& secure_prng);
@@ -84,7 +101,7 @@ public:
     void andrs(int n, const ReplicatedSecret& x, const ReplicatedSecret& y);
     void prepare_and(vector<octetStream>& os, int n,
             const ReplicatedSecret& x, const ReplicatedSecret& y,
-            Thread<U>& party, bool repeat);
+            ReplicatedBase& protocol, bool repeat);
     void finalize_andrs(vector<octetStream>& os, int n);
 
     void reveal(size_t n_bits, Clear& x);
@@ -10,6 +10,8 @@
 #include "Tools/random.h"
 #include "Processor.h"
 #include "ArgTuples.h"
+#include "Tools/TaskPool.h"
+#include "config.h"
 
 namespace GC
 {
@@ -41,9 +43,17 @@ public:
     PRNG secure_prng;
     vector<octetStream> os;
 
+    // channels for parts of AND batches that other threads may run,
+    // the first being the main one
+    vector<Player*> chunk_Ps;
+    vector<typename T::Protocol*> chunk_protocols;
+    vector<typename T::MC*> chunk_MCs;
+
     int thread_num;
-    WaitQueue<ScheduleItem> tape_schedule;
-    WaitQueue<int> done;
+    // guarded by the task pool of the master
+    deque<ScheduleItem> tape_schedule;
+    int n_done;
+    bool running;
     pthread_t thread;
 
     static Thread<T>& s();
@@ -58,15 +68,47 @@ public:
     virtual void run(Program<T>& program);
     virtual void post_run() {}
 
+    void schedule(ScheduleItem item);
+    bool next_tape(ScheduleItem& item);
     void join_tape();
     void finish();
 
+    template<class U>
+    void run_chunks(size_t n_items, U job);
+
     int n_interactive_inputs_from_me(InputArgList& args);
 };
 
 template<class T>
 thread_local Thread<T>* Thread<T>::singleton = 0;
 
+// split independent work such as AND gates into chunks that idle threads
+// can take, using a different channel for every chunk
+template<class T>
+template<class U>
+void Thread<T>::run_chunks(size_t n_items, U job)
+{
+    size_t n_chunks = min(chunk_Ps.size(),
+            max(n_items / MIN_AND_CHUNK, size_t(1)));
+    if (n_chunks == 1)
+    {
+        job(0, 0, n_items);
+        return;
+    }
+
+    int pending = 0;
+    exception_ptr error;
+    for (size_t i = 0; i < n_chunks; i++)
+    {
+        size_t begin = n_items * i / n_chunks;
+        size_t end = n_items * (i + 1) / n_chunks;
+        master.pool.push([job, i, begin, end]() { job(i, begin, end); },
+                this, pending, error);
+    }
+    // only run own chunks in order to avoid deadlocks
+    master.pool.wait(this, pending, error);
+}
+
 template<class T>
 Thread<T>& Thread<T>::s()
 {
@@ -24,8 +24,8 @@ void* Thread<T>::run_thread(void* thread)
 template<class T>
 Thread<T>::Thread(int thread_num, ThreadMaster<T>& master) :
         master(master), machine(master.machine), processor(machine),
-        protocol(0), N(master.N), P(0),
-        thread_num(thread_num)
+        MC(0), protocol(0), N(master.N), P(0),
+        thread_num(thread_num), n_done(0), running(true)
 {
     pthread_create(&thread, 0, run_thread, this);
 }
@@ -33,6 +33,12 @@ Thread<T>::Thread(int thread_num, ThreadMaster<T>& master) :
 template<class T>
 Thread<T>::~Thread()
 {
+    for (size_t i = 1; i < chunk_Ps.size(); i++)
+    {
+        delete chunk_MCs[i];
+        delete chunk_protocols[i];
+        delete chunk_Ps[i];
+    }
     if (MC)
         delete MC;
     if (P)
@@ -54,20 +60,36 @@ void Thread<T>::run()
         P = new PlainPlayer(N, thread_num << 16);
     protocol = new typename T::Protocol(*P);
     MC = this->new_mc();
+    chunk_Ps.push_back(P);
+    chunk_protocols.push_back(protocol);
+    chunk_MCs.push_back(MC);
+    if (master.work_stealing)
+        for (int i = 1; i < machine.nthreads; i++)
+        {
+            int id = (thread_num << 16) + (i << 8);
+            if (machine.use_encryption)
+                chunk_Ps.push_back(new CryptoPlayer(N, id));
+            else
+                chunk_Ps.push_back(new PlainPlayer(N, id));
+            chunk_protocols.push_back(
+                    new typename T::Protocol(*chunk_Ps.back()));
+            chunk_MCs.push_back(this->new_mc());
+        }
     processor.open_input_file(N.my_num(), thread_num);
-    done.push(0);
+    master.pool.update([&]() { n_done++; });
     pre_run();
 
     ScheduleItem item;
-    while (tape_schedule.pop_dont_stop(item))
+    while (next_tape(item))
     {
         processor.reset(machine.progs.at(item.tape), item.arg);
         run(machine.progs[item.tape]);
-        done.push(0);
+        master.pool.update([&]() { n_done++; });
     }
 
     post_run();
-    MC->Check(*P);
+    for (size_t i = 0; i < chunk_MCs.size(); i++)
+        chunk_MCs[i]->Check(*chunk_Ps[i]);
 }
 
 template<class T>
@@ -77,17 +99,49 @@ void Thread<T>::run(Program<T>& program)
         ;
 }
 
+template<class T>
+void Thread<T>::schedule(ScheduleItem item)
+{
+    master.pool.update([&]() { tape_schedule.push_back(item); });
+}
+
+// help other threads while waiting
+template<class T>
+bool Thread<T>::next_tape(ScheduleItem& item)
+{
+    bool res = false;
+    master.pool.help_until([&]()
+    {
+        if (not tape_schedule.empty())
+        {
+            item = tape_schedule.front();
+            tape_schedule.pop_front();
+            res = true;
+        }
+        return res or not running;
+    });
+    return res;
+}
+
 template<class T>
 void Thread<T>::join_tape()
 {
-    int _;
-    done.pop(_);
+    master.pool.help_until([&]()
+    {
+        if (n_done > 0)
+        {
+            n_done--;
+            return true;
+        }
+        else
+            return false;
+    });
 }
 
 template<class T>
 void Thread<T>::finish()
 {
-    tape_schedule.stop();
+    master.pool.update([&]() { running = false; });
     pthread_join(thread, 0);
 }
 
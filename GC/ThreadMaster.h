@@ -44,6 +44,10 @@ public:
 
     Player* P;
 
+    // idle threads run parts of AND batches of other threads
+    TaskPool pool;
+    bool work_stealing;
+
     Machine<T> machine;
     typename T::DynamicMemory memory;
 
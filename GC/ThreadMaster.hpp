@@ -25,7 +25,7 @@ ThreadMaster<T>& ThreadMaster<T>::s()
 
 template<class T>
 ThreadMaster<T>::ThreadMaster(OnlineOptions& opts) :
-        P(0), opts(opts)
+        P(0), work_stealing(false), opts(opts)
 {
     if (singleton)
         throw runtime_error("there can only be one");
@@ -35,7 +35,7 @@ ThreadMaster<T>::ThreadMaster(OnlineOptions& opts) :
 template<class T>
 void ThreadMaster<T>::run_tape(int thread_number, int tape_number, int arg)
 {
-    threads.at(thread_number)->tape_schedule.push({tape_number, arg});
+    threads.at(thread_number)->schedule({tape_number, arg});
 }
 
 template<class T>
@@ -64,7 +64,7 @@ void ThreadMaster<T>::run()
     Timer timer;
     timer.start();
 
-    threads[0]->tape_schedule.push(0);
+    threads[0]->schedule(0);
 
     for (auto thread : threads)
         thread->finish();
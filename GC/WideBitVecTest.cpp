@@ -0,0 +1,88 @@
+/*
+ * WideBitVecTest.cpp
+ *
+ */
+
+#include "WideSquare.h"
+#include "Tools/random.h"
+
+#include <iostream>
+#include <stdlib.h>
+using namespace std;
+
+int n_errors = 0;
+
+void fail(const char* name, int L, int n)
+{
+    cerr << name << " failed at width " << L << " for " << n << endl;
+    n_errors++;
+}
+
+template<int L>
+void check_shifts(PRNG& G)
+{
+    WideBitVec<L> x;
+    x.randomize(G);
+    for (int n = 0; n < L; n++)
+    {
+        auto left = x << n, right = x >> n, masked = x.mask(n);
+        for (int i = 0; i < L; i++)
+        {
+            if (left.get_bit(i) != (i >= n and x.get_bit(i - n)))
+                fail("left shift", L, n);
+            if (right.get_bit(i) != (i + n < L and x.get_bit(i + n)))
+                fail("right shift", L, n);
+            if (masked.get_bit(i) != (i < n and x.get_bit(i)))
+                fail("mask", L, n);
+        }
+    }
+}
+
+template<int L>
+void check_transpose(PRNG& G, int n_rows, int n_cols)
+{
+    WideSquare<L> square;
+    // like ReplicatedSecret::trans(), only the first n_rows rows are set
+    // and only the first n_cols rows of the result are used
+    vector<WideBitVec<L>> rows(L);
+    for (int i = 0; i < n_rows; i++)
+    {
+        rows[i].randomize(G);
+        square.set_row(i, rows[i]);
+    }
+    square.transpose(n_rows, n_cols);
+    for (int i = 0; i < n_cols; i++)
+    {
+        auto row = square.get_row(i);
+        for (int j = 0; j < L; j++)
+            if (row.get_bit(j) != rows[j].get_bit(i))
+            {
+                fail("transpose", L, n_rows * L + n_cols);
+                return;
+            }
+    }
+}
+
+template<int L>
+void check(PRNG& G)
+{
+    check_shifts<L>(G);
+    int sizes[] = { 1, 63, 64, 65, L / 2, L - 1, L };
+    for (int n_rows : sizes)
+        for (int n_cols : sizes)
+            check_transpose<L>(G, n_rows, n_cols);
+}
+
+int main()
+{
+    PRNG G;
+    G.ReSeed();
+    check<256>(G);
+    check<512>(G);
+    if (n_errors)
+    {
+        cerr << n_errors << " errors" << endl;
+        exit(1);
+    }
+    cout << "All tests passed" << endl;
+}
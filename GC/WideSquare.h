@@ -0,0 +1,64 @@
+/*
+ * WideSquare.h
+ *
+ */
+
+#ifndef GC_WIDESQUARE_H_
+#define GC_WIDESQUARE_H_
+
+#include "square64.h"
+#include "Math/WideBitVec.h"
+
+/*
+ * L x L bit matrix as blocks of square64 so that the transpose
+ * uses the AVX2 transpose of 64 x 64 blocks.
+ */
+template<int L>
+class WideSquare
+{
+    static const int N_BLOCKS = L / 64;
+
+    // blocks[i][j] holds rows 64 * i... and columns 64 * j...
+    square64 blocks[N_BLOCKS][N_BLOCKS];
+
+public:
+    void set_row(int i, const WideBitVec<L>& row)
+    {
+        for (int j = 0; j < N_BLOCKS; j++)
+            blocks[i / 64][j].rows[i % 64] = row.get_word(j);
+    }
+
+    WideBitVec<L> get_row(int i) const
+    {
+        WideBitVec<L> res;
+        for (int j = 0; j < N_BLOCKS; j++)
+            res.set_word(j, blocks[i / 64][j].rows[i % 64]);
+        return res;
+    }
+
+    void transpose(int n_rows, int n_cols)
+    {
+        for (int i = 0; i < N_BLOCKS; i++)
+            for (int j = i; j < N_BLOCKS; j++)
+            {
+                auto& x = blocks[i][j];
+                auto& y = blocks[j][i];
+                if (64 * i < n_rows and 64 * j < n_cols)
+                    x.transpose(min(64, n_rows - 64 * i),
+                            min(64, n_cols - 64 * j));
+                else
+                    x = {};
+                if (i != j)
+                {
+                    if (64 * j < n_rows and 64 * i < n_cols)
+                        y.transpose(min(64, n_rows - 64 * j),
+                                min(64, n_cols - 64 * i));
+                    else
+                        y = {};
+                    swap(x, y);
+                }
+            }
+    }
+};
+
+#endif /* GC_WIDESQUARE_H_ */
@@ -12,4 +12,14 @@
 
 //#define CHECK_SIZE
 
+// minimum number of AND gates per chunk for idle threads
+#ifndef MIN_AND_CHUNK
+#define MIN_AND_CHUNK 1000
+#endif
+
+// register width of replicated binary secret sharing: 64, 256, or 512
+#ifndef REPLICATED_BITS
+#define REPLICATED_BITS 64
+#endif
+
 #endif /* GC_CONFIG_H_ */
@@ -56,12 +56,23 @@ ShamirMachine::ShamirMachine(int argc, const char** argv)
             "-T", // Flag token.
             "--threshold" // Flag token.
     );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Multiply with double sharings and a rotating king "
+                    "(linear instead of quadratic communication)", // Help description.
+            "-K", // Flag token.
+            "--king" // Flag token.
+    );
     opt.parse(argc, argv);
     opt.get("-N")->getInt(nparties);
     if (opt.isSet("-T"))
         opt.get("-T")->getInt(threshold);
     else
         threshold = (nparties - 1) / 2;
+    king = opt.isSet("-K");
 #ifdef VERBOSE
     cerr << "Using threshold " << threshold << " out of " << nparties << endl;
 #endif
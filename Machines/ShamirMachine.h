@@ -18,6 +18,7 @@ protected:
 
 public:
     int threshold;
+    bool king;
 
     static ShamirMachine& s();
 
@@ -0,0 +1,57 @@
+/*
+ * MatrixMul.h
+ *
+ */
+
+#ifndef MATH_MATRIXMUL_H_
+#define MATH_MATRIXMUL_H_
+
+#include "Math/gfp.h"
+
+// ans[i] += x * y[i]
+template<class U>
+inline void mul_add(U* ans, const U& x, const U* y, int n)
+{
+    for (int i = 0; i < n; i++)
+        ans[i] += x * y[i];
+}
+
+template<int X>
+inline void mul_add(gfp_<X>* ans, const gfp_<X>& x, const gfp_<X>* y, int n)
+{
+    const int chunk = 64;
+    gfp_<X> xs[chunk], tmp[chunk];
+    for (auto& z : xs)
+        z = x;
+    for (int i = 0; i < n; i += chunk)
+    {
+        int m = min(chunk, n - i);
+        gfp_<X>::mul(tmp, xs, y + i, m);
+        gfp_<X>::add(ans + i, ans + i, tmp, m);
+    }
+}
+
+/*
+ * C += A * B for row-major matrices A (m x n), B (n x k), and C (m x k).
+ * B is processed in tiles that stay in cache while all rows of A pass
+ * over them, and the innermost loop runs over contiguous rows.
+ */
+template<class U>
+void matrix_mul_add(U* C, const U* A, const U* B, int m, int n, int k)
+{
+    const int tile_rows = 32, tile_cols = 128;
+    for (int j = 0; j < k; j += tile_cols)
+    {
+        int width = min(tile_cols, k - j);
+        for (int l = 0; l < n; l += tile_rows)
+        {
+            int depth = min(tile_rows, n - l);
+            for (int i = 0; i < m; i++)
+                for (int ll = l; ll < l + depth; ll++)
+                    mul_add(C + i * k + j, A[i * n + ll], B + ll * k + j,
+                            width);
+        }
+    }
+}
+
+#endif /* MATH_MATRIXMUL_H_ */
@@ -0,0 +1,190 @@
+/*
+ * WideBitVec.h
+ *
+ */
+
+#ifndef MATH_WIDEBITVEC_H_
+#define MATH_WIDEBITVEC_H_
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "Integer.h"
+#include "field_types.h"
+
+/*
+ * Bit vector like BitVec but with L bits, L being a multiple of 256.
+ * XOR and AND run on 256-bit lanes. Storage is not necessarily
+ * aligned because vectors of shares do not guarantee it.
+ */
+template<int L>
+class WideBitVec : public ValueInterface
+{
+    static_assert(L % 256 == 0, "width must be a multiple of 256");
+
+    static const int N_WORDS = L / 64;
+
+    unsigned long a[N_WORDS];
+
+    __m256i lane(int i) const
+    {
+        return _mm256_loadu_si256((const __m256i*) a + i);
+    }
+    void set_lane(int i, __m256i x)
+    {
+        _mm256_storeu_si256((__m256i*) a + i, x);
+    }
+
+public:
+    static const int n_bits = L;
+
+    static int size() { return L / 8; }
+    static string type_string() { return "bit vector of length " + to_string(L); }
+    static char type_char() { return 'B'; }
+    static DataFieldType field_type() { return DATA_GF2; }
+
+    static bool allows(Dtype dtype) { return dtype == DATA_TRIPLE or dtype == DATA_BIT; }
+
+    static WideBitVec unpack_new(octetStream& os, int n = n_bits)
+    {
+        WideBitVec res;
+        res.unpack(os, n);
+        return res;
+    }
+
+    WideBitVec() { assign_zero(); }
+    // sign extension like BitVec
+    WideBitVec(long x)
+    {
+        a[0] = x;
+        for (int i = 1; i < N_WORDS; i++)
+            a[i] = x < 0 ? -1 : 0;
+    }
+    WideBitVec(const IntBase& x) : WideBitVec(x.get()) {}
+
+    long get() const { return a[0]; }
+    bool get_bit(int i) const { return (a[i / 64] >> (i % 64)) & 1; }
+
+    unsigned long get_word(int i) const { return a[i]; }
+    void set_word(int i, unsigned long x) { a[i] = x; }
+
+    void assign_zero() { memset(a, 0, sizeof(a)); }
+    void assign(const char* buffer) { memcpy(a, buffer, sizeof(a)); }
+
+    bool is_zero() const { return *this == WideBitVec(); }
+
+    WideBitVec operator^(const WideBitVec& other) const
+    {
+        WideBitVec res;
+        for (int i = 0; i < L / 256; i++)
+            res.set_lane(i, _mm256_xor_si256(lane(i), other.lane(i)));
+        return res;
+    }
+    WideBitVec operator&(const WideBitVec& other) const
+    {
+        WideBitVec res;
+        for (int i = 0; i < L / 256; i++)
+            res.set_lane(i, _mm256_and_si256(lane(i), other.lane(i)));
+        return res;
+    }
+
+    WideBitVec operator+(const WideBitVec& other) const { return *this ^ other; }
+    WideBitVec operator-(const WideBitVec& other) const { return *this ^ other; }
+    WideBitVec operator*(const WideBitVec& other) const { return *this & other; }
+
+    WideBitVec& operator^=(const WideBitVec& other) { return *this = *this ^ other; }
+    WideBitVec& operator&=(const WideBitVec& other) { return *this = *this & other; }
+    WideBitVec& operator+=(const WideBitVec& other) { return *this ^= other; }
+
+    bool operator==(const WideBitVec& other) const
+    {
+        return memcmp(a, other.a, sizeof(a)) == 0;
+    }
+    bool operator!=(const WideBitVec& other) const { return not (*this == other); }
+
+    // logical shifts
+    WideBitVec operator<<(int n) const
+    {
+        WideBitVec res;
+        int words = n / 64, bits = n % 64;
+        for (int i = N_WORDS - 1; i >= words; i--)
+        {
+            res.a[i] = a[i - words] << bits;
+            if (bits and i > words)
+                res.a[i] |= a[i - words - 1] >> (64 - bits);
+        }
+        return res;
+    }
+    WideBitVec operator>>(int n) const
+    {
+        WideBitVec res;
+        int words = n / 64, bits = n % 64;
+        for (int i = 0; i < N_WORDS - words; i++)
+        {
+            res.a[i] = a[i + words] >> bits;
+            if (bits and i + words + 1 < N_WORDS)
+                res.a[i] |= a[i + words + 1] << (64 - bits);
+        }
+        return res;
+    }
+
+    void mul(const WideBitVec& x, const WideBitVec& y) { *this = x * y; }
+
+    WideBitVec extend_bit() const { return -long(a[0] & 1); }
+
+    WideBitVec mask(int n) const
+    {
+        WideBitVec res = *this;
+        for (int i = 0; i < N_WORDS; i++)
+            if (n <= 64 * i)
+                res.a[i] = 0;
+            else if (n < 64 * (i + 1))
+                res.a[i] &= (1UL << (n - 64 * i)) - 1;
+        return res;
+    }
+
+    void randomize(PRNG& G) { G.get_octets((octet*) a, sizeof(a)); }
+
+    void pack(octetStream& os, int n = n_bits) const
+    {
+        os.append((octet*) a, DIV_CEIL(n, 8));
+    }
+    void unpack(octetStream& os, int n = n_bits)
+    {
+        assign_zero();
+        os.consume((octet*) a, DIV_CEIL(n, 8));
+    }
+
+    void output(ostream& s, bool human) const
+    {
+        if (human)
+        {
+            s << hex;
+            for (int i = N_WORDS - 1; i >= 0; i--)
+                s << a[i] << (i ? " " : "");
+            s << dec;
+        }
+        else
+            s.write((char*) a, sizeof(a));
+    }
+    void input(istream& s, bool human)
+    {
+        if (human)
+        {
+            s >> hex;
+            for (int i = N_WORDS - 1; i >= 0; i--)
+                s >> a[i];
+            s >> dec;
+        }
+        else
+            s.read((char*) a, sizeof(a));
+    }
+
+    friend ostream& operator<<(ostream& s, const WideBitVec& x)
+    {
+        x.output(s, true);
+        return s;
+    }
+};
+
+#endif /* MATH_WIDEBITVEC_H_ */
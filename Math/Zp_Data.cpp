@@ -1,6 +1,10 @@
 
 #include "Zp_Data.h"
+#include "modp.h"
 #include "mpn_fixed.h"
+#include "Tools/cpu_support.h"
+
+#include <immintrin.h>
 
 
 void Zp_Data::init(const bigint& p,bool mont)
@@ -79,6 +83,315 @@ void Zp_Data::Mont_Mult_variable(mp_limb_t* z,const mp_limb_t* x,const mp_limb_t
 
 
 
+/*
+ * Batch kernels on arrays of modp.
+ *
+ * Single-limb kernels process every limb of the array, which is fine
+ * because the unused limbs of a modp are always zero and stay zero.
+ * The return value is the number of elements processed, the rest is
+ * left to the scalar code.
+ */
+
+static const int LIMBS = sizeof(modp) / sizeof(mp_limb_t);
+
+// some versions of GCC warn about _mm512_undefined_epi32() in intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#define AVX512 "avx512f,avx512dq"
+
+__attribute__((target(AVX512)))
+static int add1_avx512(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, mp_limb_t p)
+{
+  __m512i pp = _mm512_set1_epi64(p);
+  int n_limbs = n * LIMBS;
+  for (int i = 0; i < n_limbs; i += 8)
+    {
+      __mmask8 m = n_limbs - i >= 8 ? 0xff : (1 << (n_limbs - i)) - 1;
+      __m512i a = _mm512_maskz_loadu_epi64(m, x + i);
+      __m512i b = _mm512_maskz_loadu_epi64(m, y + i);
+      __m512i s = _mm512_add_epi64(a, b);
+      __mmask8 sub = _mm512_cmplt_epu64_mask(s, a)
+          | _mm512_cmpge_epu64_mask(s, pp);
+      s = _mm512_mask_sub_epi64(s, sub, s, pp);
+      _mm512_mask_storeu_epi64(ans + i, m, s);
+    }
+  return n;
+}
+
+__attribute__((target(AVX512)))
+static int sub1_avx512(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, mp_limb_t p)
+{
+  __m512i pp = _mm512_set1_epi64(p);
+  int n_limbs = n * LIMBS;
+  for (int i = 0; i < n_limbs; i += 8)
+    {
+      __mmask8 m = n_limbs - i >= 8 ? 0xff : (1 << (n_limbs - i)) - 1;
+      __m512i a = _mm512_maskz_loadu_epi64(m, x + i);
+      __m512i b = _mm512_maskz_loadu_epi64(m, y + i);
+      __m512i d = _mm512_sub_epi64(a, b);
+      d = _mm512_mask_add_epi64(d, _mm512_cmplt_epu64_mask(a, b), d, pp);
+      _mm512_mask_storeu_epi64(ans + i, m, d);
+    }
+  return n;
+}
+
+// full 64x64-bit product from 32-bit partial products
+__attribute__((target(AVX512)))
+static inline void mul64_avx512(__m512i& hi, __m512i& lo, __m512i a, __m512i b)
+{
+  __m512i mask = _mm512_set1_epi64(0xffffffff);
+  __m512i a_hi = _mm512_srli_epi64(a, 32);
+  __m512i b_hi = _mm512_srli_epi64(b, 32);
+  __m512i ll = _mm512_mul_epu32(a, b);
+  __m512i lh = _mm512_mul_epu32(a, b_hi);
+  __m512i hl = _mm512_mul_epu32(a_hi, b);
+  __m512i hh = _mm512_mul_epu32(a_hi, b_hi);
+  __m512i mid = _mm512_add_epi64(_mm512_srli_epi64(ll, 32),
+      _mm512_add_epi64(_mm512_and_si512(lh, mask), _mm512_and_si512(hl, mask)));
+  lo = _mm512_or_si512(_mm512_and_si512(ll, mask), _mm512_slli_epi64(mid, 32));
+  hi = _mm512_add_epi64(
+      _mm512_add_epi64(hh, _mm512_srli_epi64(mid, 32)),
+      _mm512_add_epi64(_mm512_srli_epi64(lh, 32), _mm512_srli_epi64(hl, 32)));
+}
+
+__attribute__((target(AVX512)))
+static int mul1_avx512(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, mp_limb_t p, mp_limb_t pi)
+{
+  __m512i pp = _mm512_set1_epi64(p);
+  __m512i ppi = _mm512_set1_epi64(pi);
+  __m512i one = _mm512_set1_epi64(1);
+  int n_limbs = n * LIMBS;
+  for (int i = 0; i < n_limbs; i += 8)
+    {
+      __mmask8 m = n_limbs - i >= 8 ? 0xff : (1 << (n_limbs - i)) - 1;
+      __m512i a = _mm512_maskz_loadu_epi64(m, x + i);
+      __m512i b = _mm512_maskz_loadu_epi64(m, y + i);
+      __m512i th, tl, uh, ul;
+      mul64_avx512(th, tl, a, b);
+      // u = (t * pi mod R) * p, so that t + u = 0 mod R
+      __m512i u = _mm512_mullo_epi64(tl, ppi);
+      mul64_avx512(uh, ul, u, pp);
+      // the lower halves only produce a carry
+      __mmask8 carry = _mm512_test_epi64_mask(tl, tl);
+      __m512i s = _mm512_add_epi64(th, uh);
+      __mmask8 overflow = _mm512_cmplt_epu64_mask(s, th);
+      s = _mm512_mask_add_epi64(s, carry, s, one);
+      overflow |= carry & _mm512_cmpeq_epu64_mask(s, _mm512_setzero_si512());
+      __mmask8 sub = overflow | _mm512_cmpge_epu64_mask(s, pp);
+      s = _mm512_mask_sub_epi64(s, sub, s, pp);
+      _mm512_mask_storeu_epi64(ans + i, m, s);
+    }
+  return n;
+}
+
+// two-limb kernels work on eight elements split into lower and upper limbs
+__attribute__((target(AVX512)))
+static inline void load2_avx512(__m512i& lo, __m512i& hi, const mp_limb_t* x)
+{
+  __m512i a = _mm512_loadu_si512(x);
+  __m512i b = _mm512_loadu_si512(x + 8);
+  lo = _mm512_permutex2var_epi64(a,
+      _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), b);
+  hi = _mm512_permutex2var_epi64(a,
+      _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), b);
+}
+
+__attribute__((target(AVX512)))
+static inline void store2_avx512(mp_limb_t* x, __m512i lo, __m512i hi)
+{
+  _mm512_storeu_si512(x, _mm512_permutex2var_epi64(lo,
+      _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0), hi));
+  _mm512_storeu_si512(x + 8, _mm512_permutex2var_epi64(lo,
+      _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4), hi));
+}
+
+__attribute__((target(AVX512)))
+static int add2_avx512(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, const mp_limb_t* p)
+{
+  if (LIMBS != 2)
+    return 0;
+  __m512i pl = _mm512_set1_epi64(p[0]);
+  __m512i ph = _mm512_set1_epi64(p[1]);
+  __m512i one = _mm512_set1_epi64(1);
+  int i;
+  for (i = 0; i + 8 <= n; i += 8)
+    {
+      __m512i al, ah, bl, bh;
+      load2_avx512(al, ah, x + 2 * i);
+      load2_avx512(bl, bh, y + 2 * i);
+      __m512i sl = _mm512_add_epi64(al, bl);
+      __mmask8 carry = _mm512_cmplt_epu64_mask(sl, al);
+      __m512i c = _mm512_mask_add_epi64(bh, carry, bh, one);
+      __mmask8 overflow = carry & _mm512_cmpeq_epu64_mask(c,
+          _mm512_setzero_si512());
+      __m512i sh = _mm512_add_epi64(ah, c);
+      overflow |= _mm512_cmplt_epu64_mask(sh, ah);
+      __mmask8 sub = overflow | _mm512_cmpgt_epu64_mask(sh, ph)
+          | (_mm512_cmpeq_epu64_mask(sh, ph) & _mm512_cmpge_epu64_mask(sl, pl));
+      __mmask8 borrow = sub & _mm512_cmplt_epu64_mask(sl, pl);
+      sl = _mm512_mask_sub_epi64(sl, sub, sl, pl);
+      sh = _mm512_mask_sub_epi64(sh, sub, sh, ph);
+      sh = _mm512_mask_sub_epi64(sh, borrow, sh, one);
+      store2_avx512(ans + 2 * i, sl, sh);
+    }
+  return i;
+}
+
+__attribute__((target(AVX512)))
+static int sub2_avx512(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, const mp_limb_t* p)
+{
+  if (LIMBS != 2)
+    return 0;
+  __m512i pl = _mm512_set1_epi64(p[0]);
+  __m512i ph = _mm512_set1_epi64(p[1]);
+  __m512i one = _mm512_set1_epi64(1);
+  int i;
+  for (i = 0; i + 8 <= n; i += 8)
+    {
+      __m512i al, ah, bl, bh;
+      load2_avx512(al, ah, x + 2 * i);
+      load2_avx512(bl, bh, y + 2 * i);
+      __m512i dl = _mm512_sub_epi64(al, bl);
+      __mmask8 borrow = _mm512_cmplt_epu64_mask(al, bl);
+      __m512i dh = _mm512_sub_epi64(ah, bh);
+      __mmask8 add = _mm512_cmplt_epu64_mask(ah, bh)
+          | (borrow & _mm512_cmpeq_epu64_mask(ah, bh));
+      dh = _mm512_mask_sub_epi64(dh, borrow, dh, one);
+      __m512i rl = _mm512_mask_add_epi64(dl, add, dl, pl);
+      __mmask8 carry = add & _mm512_cmplt_epu64_mask(rl, dl);
+      dh = _mm512_mask_add_epi64(dh, add, dh, ph);
+      dh = _mm512_mask_add_epi64(dh, carry, dh, one);
+      store2_avx512(ans + 2 * i, rl, dh);
+    }
+  return i;
+}
+
+#pragma GCC diagnostic pop
+
+// AVX2 lacks unsigned comparison, hence the sign flips
+static int add1_avx2(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, mp_limb_t p)
+{
+#ifdef __AVX2__
+  __m256i pp = _mm256_set1_epi64x(p);
+  __m256i sign = _mm256_set1_epi64x(1ll << 63);
+  __m256i ps = _mm256_xor_si256(pp, sign);
+  int n_limbs = n * LIMBS;
+  int i;
+  for (i = 0; i + 4 <= n_limbs; i += 4)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)(x + i));
+      __m256i b = _mm256_loadu_si256((__m256i*)(y + i));
+      __m256i s = _mm256_add_epi64(a, b);
+      __m256i ss = _mm256_xor_si256(s, sign);
+      __m256i carry = _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), ss);
+      __m256i less = _mm256_cmpgt_epi64(ps, ss);
+      __m256i sub = _mm256_andnot_si256(_mm256_andnot_si256(carry, less), pp);
+      _mm256_storeu_si256((__m256i*)(ans + i), _mm256_sub_epi64(s, sub));
+    }
+  return i / LIMBS;
+#else
+  (void) ans, (void) x, (void) y, (void) n, (void) p;
+  return 0;
+#endif
+}
+
+static int sub1_avx2(mp_limb_t* ans, const mp_limb_t* x,
+    const mp_limb_t* y, int n, mp_limb_t p)
+{
+#ifdef __AVX2__
+  __m256i pp = _mm256_set1_epi64x(p);
+  __m256i sign = _mm256_set1_epi64x(1ll << 63);
+  int n_limbs = n * LIMBS;
+  int i;
+  for (i = 0; i + 4 <= n_limbs; i += 4)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)(x + i));
+      __m256i b = _mm256_loadu_si256((__m256i*)(y + i));
+      __m256i borrow = _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign),
+          _mm256_xor_si256(a, sign));
+      __m256i d = _mm256_sub_epi64(a, b);
+      d = _mm256_add_epi64(d, _mm256_and_si256(borrow, pp));
+      _mm256_storeu_si256((__m256i*)(ans + i), d);
+    }
+  return i / LIMBS;
+#else
+  (void) ans, (void) x, (void) y, (void) n, (void) p;
+  return 0;
+#endif
+}
+
+void Zp_Data::Add(modp* ans,const modp* x,const modp* y,int n) const
+{
+  static bool avx512 = cpu_has_avx512dq();
+  int i = 0;
+  switch (t)
+  {
+  case 1:
+    if (avx512)
+      i = add1_avx512(ans->x, x->x, y->x, n, prA[0]);
+    else
+      i = add1_avx2(ans->x, x->x, y->x, n, prA[0]);
+    for (; i < n; i++)
+      Add<1>(ans[i].x, x[i].x, y[i].x);
+    break;
+  case 2:
+    if (avx512)
+      i = add2_avx512(ans->x, x->x, y->x, n, prA);
+    for (; i < n; i++)
+      Add<2>(ans[i].x, x[i].x, y[i].x);
+    break;
+  default:
+    for (; i < n; i++)
+      Add(ans[i].x, x[i].x, y[i].x);
+    break;
+  }
+}
+
+void Zp_Data::Sub(modp* ans,const modp* x,const modp* y,int n) const
+{
+  static bool avx512 = cpu_has_avx512dq();
+  int i = 0;
+  switch (t)
+  {
+  case 1:
+    if (avx512)
+      i = sub1_avx512(ans->x, x->x, y->x, n, prA[0]);
+    else
+      i = sub1_avx2(ans->x, x->x, y->x, n, prA[0]);
+    for (; i < n; i++)
+      Sub<1>(ans[i].x, x[i].x, y[i].x);
+    break;
+  case 2:
+    if (avx512)
+      i = sub2_avx512(ans->x, x->x, y->x, n, prA);
+    for (; i < n; i++)
+      Sub<2>(ans[i].x, x[i].x, y[i].x);
+    break;
+  default:
+    for (; i < n; i++)
+      Sub(ans[i].x, x[i].x, y[i].x);
+    break;
+  }
+}
+
+void Zp_Data::Mul(modp* ans,const modp* x,const modp* y,int n) const
+{
+  static bool avx512 = cpu_has_avx512dq();
+  int i = 0;
+  if (montgomery and t == 1 and avx512)
+    i = mul1_avx512(ans->x, x->x, y->x, n, prA[0], pi);
+  for (; i < n; i++)
+    ::Mul(ans[i], x[i], y[i], *this);
+}
+
+
 ostream& operator<<(ostream& s,const Zp_Data& ZpD)
 {
   s << ZpD.pr << " " << ZpD.montgomery << endl;
@@ -74,6 +74,11 @@ class Zp_Data
   void Sub(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const;
   void Sub(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const;
 
+  // element-wise on arrays, using SIMD for one and two limbs if possible
+  void Add(modp* ans,const modp* x,const modp* y,int n) const;
+  void Sub(modp* ans,const modp* x,const modp* y,int n) const;
+  void Mul(modp* ans,const modp* x,const modp* y,int n) const;
+
   __m128i get_random128(PRNG& G);
 
   bool operator!=(const Zp_Data& other) const;
@@ -148,6 +148,14 @@ class gfp_
   void mul(const gfp_& x)
     { Mul(a,a,x.a,ZpD); }
 
+  // element-wise on arrays of length n
+  static void add(gfp_* ans,const gfp_* x,const gfp_* y,int n)
+    { ZpD.Add(&ans->a,&x->a,&y->a,n); }
+  static void sub(gfp_* ans,const gfp_* x,const gfp_* y,int n)
+    { ZpD.Sub(&ans->a,&x->a,&y->a,n); }
+  static void mul(gfp_* ans,const gfp_* x,const gfp_* y,int n)
+    { ZpD.Mul(&ans->a,&x->a,&y->a,n); }
+
   gfp_ operator+(const gfp_& x) const { gfp_ res; res.add(*this, x); return res; }
   gfp_ operator-(const gfp_& x) const { gfp_ res; res.sub(*this, x); return res; }
   gfp_ operator*(const gfp_& x) const { gfp_ res; res.mul(*this, x); return res; }
@@ -92,6 +92,7 @@ class modp
 
   template<int X>
   friend class gfp_;
+  friend class Zp_Data;
 };
 
 
@@ -184,7 +184,6 @@ Player::Player(const Names& Nms) :
 {
   nplayers=Nms.nplayers;
   player_no=Nms.player_no;
-  blk_SHA1_Init(&ctx);
 }
 
 
@@ -199,6 +198,7 @@ MultiPlayer<T>::MultiPlayer(const Names& Nms, int id) :
 template<>
 MultiPlayer<int>::~MultiPlayer()
 {
+  delete_exchangers();
   /* Close down the sockets */
   for (auto socket : sockets)
     close_client_socket(socket);
@@ -208,6 +208,16 @@ MultiPlayer<int>::~MultiPlayer()
 template<class T>
 MultiPlayer<T>::~MultiPlayer()
 {
+  delete_exchangers();
+}
+
+template<class T>
+void MultiPlayer<T>::delete_exchangers()
+{
+  // joins the threads before the sockets are closed
+  for (auto exchanger : exchangers)
+    delete exchanger;
+  exchangers.clear();
 }
 
 Player::~Player()
@@ -295,7 +305,7 @@ void Player::send_to(int player,const octetStream& o,bool donthash) const
   TimeScope ts(comm_stats["Sending directly"].add(o));
   send_to_no_stats(player, o);
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
   sent += o.get_length();
 }
 
@@ -316,7 +326,7 @@ void MultiPlayer<T>::send_all(const octetStream& o,bool donthash) const
          { o.Send(sockets[i]); }
      }
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
   sent += o.get_length() * (num_players() - 1);
 }
 
@@ -326,7 +336,7 @@ void Player::receive_player(int i,octetStream& o,bool donthash) const
   TimeScope ts(timer);
   receive_player_no_stats(i, o);
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
 }
 
 template<class T>
@@ -405,21 +415,85 @@ void MultiPlayer<T>::pass_around(octetStream& o, octetStream& to_receive, int of
 /* This is deliberately weird to avoid problems with OS max buffer
  * size getting in the way
  */
+template<class T>
+int ExchangeJob<T>::run()
+{
+  try
+    {
+      to_send->exchange(socket, socket, *to_receive);
+      // hash while waiting for the other players
+      if (hash)
+        {
+          SHA256Hash sha;
+          sha.update(*to_receive);
+          sha.final(digest);
+        }
+      return 0;
+    }
+  catch (exception& e)
+    {
+      error = e.what();
+      return 1;
+    }
+}
+
 template<class T>
 void MultiPlayer<T>::Broadcast_Receive(vector<octetStream>& o,bool donthash) const
 {
   if (o.size() != sockets.size())
     throw runtime_error("player numbers don't match");
   TimeScope ts(comm_stats["Broadcasting"].add(o[player_no]));
-  for (int i=1; i<nplayers; i++)
+  if (nplayers > 2)
     {
-      int send_to = (my_num() + i) % num_players();
-      int receive_from = (my_num() + num_players() - i) % num_players();
-      o[my_num()].exchange(sockets[send_to], sockets[receive_from], o[receive_from]);
+      // exchange with all other players at the same time
+      // so that a slow link only delays itself
+      if (exchangers.empty())
+        {
+          exchange_jobs.resize(nplayers);
+          for (int i = 0; i < nplayers; i++)
+            exchangers.push_back(i == my_num() ? 0 : new Worker<ExchangeJob<T>>);
+        }
+      for (int i = 0; i < nplayers; i++)
+        if (i != my_num())
+          {
+            auto& job = exchange_jobs[i];
+            job.socket = sockets[i];
+            job.to_send = &o[my_num()];
+            job.to_receive = &o[i];
+            job.hash = not donthash;
+            exchangers[i]->request(job);
+          }
+      octet digest[SHA256Hash::hash_length];
+      if (!donthash)
+        {
+          SHA256Hash sha;
+          sha.update(o[my_num()]);
+          sha.final(digest);
+        }
+      string error;
+      for (int i = 0; i < nplayers; i++)
+        if (i != my_num() and exchangers[i]->done())
+          error = exchange_jobs[i].error;
+      if (not error.empty())
+        throw runtime_error("broadcast failed: " + error);
+      // hash of hashes in player order
+      if (!donthash)
+        for (int i = 0; i < nplayers; i++)
+          ctx.update(i == my_num() ? digest : exchange_jobs[i].digest,
+              SHA256Hash::hash_length);
     }
-  if (!donthash)
-    { for (int i=0; i<nplayers; i++)
-        { blk_SHA1_Update(&ctx,o[i].get_data(),o[i].get_length()); }
+  else
+    {
+      for (int i=1; i<nplayers; i++)
+        {
+          int send_to = (my_num() + i) % num_players();
+          int receive_from = (my_num() + num_players() - i) % num_players();
+          o[my_num()].exchange(sockets[send_to], sockets[receive_from], o[receive_from]);
+        }
+      if (!donthash)
+        { for (int i=0; i<nplayers; i++)
+            { ctx.update(o[i]); }
+        }
     }
   sent += o[player_no].get_length() * (num_players() - 1);
 }
@@ -429,10 +503,10 @@ void Player::Check_Broadcast() const
 {
   if (ctx.size == 0)
     return;
-  octet hashVal[HASH_SIZE];
+  octet hashVal[SHA256Hash::hash_length];
   vector<octetStream> h(nplayers);
-  blk_SHA1_Final(hashVal,&ctx);
-  h[player_no].append(hashVal,HASH_SIZE);
+  ctx.final(hashVal);
+  h[player_no].append(hashVal,SHA256Hash::hash_length);
 
   Broadcast_Receive(h,true);
   for (int i=0; i<nplayers; i++)
@@ -441,7 +515,6 @@ void Player::Check_Broadcast() const
 	    { throw broadcast_invalid(); }
         }
     }
-  blk_SHA1_Init(&ctx);
 }
 
 template<>
@@ -537,7 +610,7 @@ void ThreadPlayer::send_all(const octetStream& o,bool donthash) const
      }
 
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
 
   for (int i = 0; i < nplayers; i++)
     if (i != player_no)
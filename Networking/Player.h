@@ -19,9 +19,11 @@ using namespace std;
 #include "Networking/sockets.h"
 #include "Networking/ServerSocket.h"
 #include "Tools/sha1.h"
+#include "Tools/sha256.h"
 #include "Tools/int.h"
 #include "Networking/Receiver.h"
 #include "Networking/Sender.h"
+#include "Tools/Worker.h"
 
 typedef vector<octet> public_signing_key;
 typedef vector<octet> secret_signing_key;
@@ -138,7 +140,7 @@ class Player : public PlayerBase
 protected:
   int nplayers;
 
-  mutable blk_SHA_CTX ctx;
+  mutable SHA256Hash ctx;
 
 public:
   const Names& N;
@@ -193,6 +195,21 @@ public:
   virtual void wait_receive(int i, octetStream& o, bool donthash=false) const { receive_player(i, o, donthash); }
 };
 
+// exchange with one other player in a background thread
+template<class T>
+class ExchangeJob
+{
+public:
+  T socket;
+  const octetStream* to_send;
+  octetStream* to_receive;
+  bool hash;
+  octet digest[SHA256Hash::hash_length];
+  string error;
+
+  int run();
+};
+
 template<class T>
 class MultiPlayer : public Player
 {
@@ -200,7 +217,12 @@ protected:
   vector<T> sockets;
   T send_to_self_socket;
 
+  // one thread per other player for concurrent broadcasting
+  mutable vector<ExchangeJob<T>> exchange_jobs;
+  mutable vector<Worker<ExchangeJob<T>>*> exchangers;
+
   void setup_sockets(const vector<string>& names,const vector<int>& ports,int id_base,ServerSocket& server);
+  void delete_exchangers();
 
   map<T,int> socket_players;
 
@@ -14,6 +14,7 @@
 #include "Math/Z2k.h"
 
 #include "OT/Rectangle.hpp"
+#include "Tools/cpu_support.h"
 
 union matrix16x8
 {
@@ -158,8 +159,17 @@ const int perm[] = { 0, 8, 4, 0xc, 2, 0xa, 6, 0xe, 1, 9, 5, 0xd, 3, 0xb, 7, 0xf
 const int perm2[] = { 0, 4, 2, 6, 1, 5, 3, 7, 8, 0xc, 0xa, 0xe, 9, 0xd, 0xb, 0xf };
 #endif
 
-UNROLL_LOOPS
 void square128::transpose()
+{
+    static bool avx512 = cpu_has_avx512_gfni();
+    if (avx512)
+        transpose_avx512();
+    else
+        transpose_generic();
+}
+
+UNROLL_LOOPS
+void square128::transpose_generic()
 {
 #ifdef USE_SUBSQUARES
     for (int j = 0; j < N_SUBSQUARES; j++)
@@ -261,6 +271,63 @@ void square128::transpose()
 #endif // __USE_SUBSQUARES__
 }
 
+#define AVX512_GFNI "avx512f,avx512bw,avx512vbmi,gfni"
+
+/*
+ * Treats the square as 16x16 blocks of 8x8 bits.
+ * First, every group of eight rows is rearranged with VPERMB such that
+ * each 64-bit word holds one block, then GF2P8AFFINEQB transposes all
+ * blocks in a register at once, and finally the blocks are gathered
+ * in their mirrored position and rearranged back into rows.
+ */
+__attribute__((target(AVX512_GFNI)))
+void square128::transpose_avx512()
+{
+    octet idx_in[128], idx_out[128];
+    for (int i = 0; i < 16; i++)
+        for (int j = 0; j < 8; j++)
+        {
+            // GF2P8AFFINEQB takes the matrix rows in reverse order
+            idx_in[8 * i + j] = 16 * (7 - j) + i;
+            idx_out[16 * j + i] = 8 * i + j;
+        }
+
+    // identity in every byte
+    __m512i identity = _mm512_set1_epi64(0x8040201008040201LL);
+    __m512i in_lo = _mm512_loadu_si512(idx_in);
+    __m512i in_hi = _mm512_loadu_si512(idx_in + 64);
+    __m512i out_lo = _mm512_loadu_si512(idx_out);
+    __m512i out_hi = _mm512_loadu_si512(idx_out + 64);
+
+    // blocks[i][j] is the transpose of input block (i, j)
+    __m512i blocks[16][2];
+    for (int i = 0; i < 16; i++)
+    {
+        __m512i a = _mm512_loadu_si512(&rows[8 * i]);
+        __m512i b = _mm512_loadu_si512(&rows[8 * i + 4]);
+        for (int j = 0; j < 2; j++)
+        {
+            __m512i x = _mm512_permutex2var_epi8(a, j ? in_hi : in_lo, b);
+            blocks[i][j] = _mm512_gf2p8affine_epi64_epi8(identity, x, 0);
+        }
+    }
+
+    // collect block (j, i) for output rows 8i to 8i+7
+    __m512i index = _mm512_set_epi64(112, 96, 80, 64, 48, 32, 16, 0);
+    for (int i = 0; i < 16; i++)
+    {
+        __m512i x[2];
+        for (int j = 0; j < 2; j++)
+            x[j] = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xff,
+                    _mm512_add_epi64(index, _mm512_set1_epi64(128 * j + i)),
+                    blocks, 8);
+        _mm512_storeu_si512(&rows[8 * i],
+                _mm512_permutex2var_epi8(x[0], out_lo, x[1]));
+        _mm512_storeu_si512(&rows[8 * i + 4],
+                _mm512_permutex2var_epi8(x[0], out_hi, x[1]));
+    }
+}
+
 void square128::randomize(PRNG& G)
 {
     G.get_octets((octet*)&rows, sizeof(rows));
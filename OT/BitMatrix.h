@@ -63,6 +63,8 @@ union square128 {
     template <class T>
     void conditional_add(BitVector& conditions, square128& other, int offset);
     void transpose();
+    void transpose_generic();
+    void transpose_avx512();
     template <class T>
     void hash_row_wise(MMO& mmo, square128& input);
     template <class T>
@@ -0,0 +1,60 @@
+/*
+ * BitMatrixTest.cpp
+ *
+ */
+
+#include "BitMatrix.h"
+#include "Tools/time-func.h"
+#include "Tools/cpu_support.h"
+
+#include <iostream>
+#include <stdlib.h>
+using namespace std;
+
+void check(BitMatrix& input, void (square128::*kernel)())
+{
+    BitMatrix output;
+    output.squares = input.squares;
+    for (auto& square : output.squares)
+        (square.*kernel)();
+    output.check_transpose(input);
+}
+
+void benchmark(BitMatrix& matrix, void (square128::*kernel)(), int n_loops,
+        const char* name)
+{
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < n_loops; i++)
+        for (auto& square : matrix.squares)
+            (square.*kernel)();
+    timer.stop();
+    double n = double(n_loops) * matrix.squares.size();
+    cout << name << ": " << n / timer.elapsed() << " 128x128 transposes/s, "
+            << n * 128 / timer.elapsed() << " OTs/s" << endl;
+}
+
+int main(int argc, const char** argv)
+{
+    int n_rows = argc > 1 ? atoi(argv[1]) : 1 << 16;
+    int n_loops = argc > 2 ? atoi(argv[2]) : 100;
+
+    PRNG G;
+    G.ReSeed();
+    BitMatrix matrix;
+    matrix.resize_vertical(n_rows);
+    matrix.randomize(G);
+
+    cout << "Checking generic kernel" << endl;
+    check(matrix, &square128::transpose_generic);
+    benchmark(matrix, &square128::transpose_generic, n_loops, "generic");
+
+    if (cpu_has_avx512_gfni())
+    {
+        cout << "Checking AVX-512 kernel" << endl;
+        check(matrix, &square128::transpose_avx512);
+        benchmark(matrix, &square128::transpose_avx512, n_loops, "AVX-512");
+    }
+    else
+        cout << "No AVX-512/GFNI support" << endl;
+}
@@ -22,11 +22,29 @@ OTExtensionWithMatrix OTExtensionWithMatrix::setup(TwoPartyPlayer& player,
 }
 
 OTExtensionWithMatrix::OTExtensionWithMatrix(BaseOT& baseOT, TwoPartyPlayer* player,
-        bool passive) : OTCorrelator(baseOT, player, passive)
+        bool passive) : OTCorrelator(baseOT, player, passive), agreement(-1)
 {
     G.ReSeed();
 }
 
+void OTExtensionWithMatrix::agree_on(int value, const string& error)
+{
+    assert(value >= 0 and value < 128);
+    agreement = value;
+    disagreement = error;
+}
+
+// before the first slice is finished
+void OTExtensionWithMatrix::check_agreement(octetStream& os)
+{
+    if (agreement < 0)
+        return;
+    // only the sender hears from the other party
+    if ((ot_role & SENDER) and os.get_int(1) != size_t(agreement))
+        throw runtime_error(disagreement);
+    agreement = -1;
+}
+
 void OTExtensionWithMatrix::seed(vector<BitMatrix>& baseSenderInput,
         BitMatrix& baseReceiverOutput)
 {
@@ -118,7 +136,7 @@ void OTExtensionWithMatrix::extend_correlated(int nOTs_requested, BitVector& new
     // add k + s to account for discarding k OTs
     int nOTs = nOTs_requested_rounded + 2 * 128;
 
-    int slice = nOTs / nsubloops / 128;
+    int slice = DIV_CEIL(nOTs / 128, nsubloops);
     nOTs = slice * nsubloops * 128;
     resize(nOTs);
     newReceiverInput.resize_zero(nOTs);
@@ -127,13 +145,46 @@ void OTExtensionWithMatrix::extend_correlated(int nOTs_requested, BitVector& new
     for (int i = 0; i < 4; i++)
         newReceiverInput.set_word(nOTs/64 - i - 1, G.get_word());
 
-    // subloop for first part to interleave communication with computation
-    for (int start = 0; start < nOTs / 128; start += slice)
+    // subloops to interleave communication with computation:
+    // while slice i is in transit, finish slice i - 1 and
+    // prepare slice i + 1 using two sets of buffers
+    vector<octetStream> os[2] = { vector<octetStream>(2), vector<octetStream>(2) };
+    CorrelationExchange exchanges[2];
+    // One thread for all slices, joined on destruction also on errors.
+    // An exchange in flight is drained first, which only finishes once
+    // the other party has sent its part of the slice or the connection
+    // is closed. The other party's own exchange of the slice does not
+    // depend on this party, so a local error does not block it.
+    Worker<CorrelationExchange> exchanger;
+    for (int i = 0; i < nsubloops; i++)
     {
+        int start = i * slice;
+        auto& my_os = os[i % 2];
+        for (auto& o : my_os)
+            o.reset_write_head();
+        if (i == 0 and agreement >= 0)
+            my_os[0].store_int(agreement, 1);
         expand<gf2n_long>(start, slice);
-        this->correlate<gf2n_long>(start, slice, newReceiverInput, true);
-        transpose(start, slice);
+        this->prepare_correlation<gf2n_long>(start, slice, my_os,
+                newReceiverInput);
+        if (i > 0)
+            exchanges[(i - 1) % 2].wait(exchanger);
+        exchanges[i % 2].start(exchanger, player, my_os, ot_role);
+        if (i > 0)
+        {
+            if (i == 1)
+                check_agreement(os[0][1]);
+            this->finish_correlation<gf2n_long>(start - slice, slice,
+                    os[(i - 1) % 2], true);
+            transpose(start - slice, slice);
+        }
     }
+    int last = nsubloops - 1;
+    exchanges[last % 2].wait(exchanger);
+    if (last == 0)
+        check_agreement(os[0][1]);
+    this->finish_correlation<gf2n_long>(last * slice, slice, os[last % 2], true);
+    transpose(last * slice, slice);
 
 #ifdef OTEXT_TIMER
     double elapsed;
@@ -227,12 +278,31 @@ void OTCorrelator<U>::correlate(int start, int slice,
 {
     vector<octetStream> os(2);
 
+    prepare_correlation<T>(start, slice, os, newReceiverInput, repeat);
+
+#ifdef OTEXT_TIMER
+    timeval commst1, commst2;
+    gettimeofday(&commst1, NULL);
+#endif
+    // send t0 + t1 + x
+    send_if_ot_receiver(player, os, ot_role);
+#ifdef OTEXT_TIMER
+    gettimeofday(&commst2, NULL);
+    double commstime = timeval_diff(&commst1, &commst2);
+    cout << "\t\tCommunication took time " << commstime/1000000 << endl << flush;
+    times["Communication"] += timeval_diff(&commst1, &commst2);
+#endif
+
+    finish_correlation<T>(start, slice, os, useConstantBase);
+}
+
+template <class U>
+template <class T>
+void OTCorrelator<U>::prepare_correlation(int start, int slice,
+        vector<octetStream>& os, BitVector& newReceiverInput, int repeat)
+{
     Slice<U> receiverOutputSlice(receiverOutputMatrix, start, slice);
-    Slice<U> senderOutputSlices[] = {
-            Slice<U>(senderOutputMatrices[0], start, slice),
-    };
     Slice<U> t1Slice(t1, start, slice);
-    Slice<U> uSlice(u, start, slice);
 
     // create correlation
     if (ot_role & RECEIVER)
@@ -245,12 +315,17 @@ void OTCorrelator<U>::correlate(int start, int slice,
 //        t1 ^= newReceiverInput;
 //        receiverOutputMatrix.print_side_by_side(t1);
     }
-#ifdef OTEXT_TIMER
-    timeval commst1, commst2;
-    gettimeofday(&commst1, NULL);
-#endif
-    // send t0 + t1 + x
-    send_if_ot_receiver(player, os, ot_role);
+}
+
+template <class U>
+template <class T>
+void OTCorrelator<U>::finish_correlation(int start, int slice,
+        vector<octetStream>& os, bool useConstantBase)
+{
+    Slice<U> senderOutputSlices[] = {
+            Slice<U>(senderOutputMatrices[0], start, slice),
+    };
+    Slice<U> uSlice(u, start, slice);
 
     // sender adjusts using base receiver bits
     if (ot_role & SENDER)
@@ -259,12 +334,36 @@ void OTCorrelator<U>::correlate(int start, int slice,
         uSlice.unpack(os[1]);
         senderOutputSlices[0].template conditional_add<T>(baseReceiverInput, u, !useConstantBase);
     }
-#ifdef OTEXT_TIMER
-    gettimeofday(&commst2, NULL);
-    double commstime = timeval_diff(&commst1, &commst2);
-    cout << "\t\tCommunication took time " << commstime/1000000 << endl << flush;
-    times["Communication"] += timeval_diff(&commst1, &commst2);
-#endif
+}
+
+void CorrelationExchange::start(Worker<CorrelationExchange>& worker,
+        TwoPartyPlayer* player, vector<octetStream>& os, OT_ROLE role)
+{
+    this->player = player;
+    this->os = &os;
+    this->role = role;
+    error.clear();
+    worker.request(*this);
+}
+
+int CorrelationExchange::run()
+{
+    try
+    {
+        send_if_ot_receiver(player, *os, role);
+    }
+    catch (exception& e)
+    {
+        error = e.what();
+    }
+    return 0;
+}
+
+void CorrelationExchange::wait(Worker<CorrelationExchange>& worker)
+{
+    worker.done();
+    if (not error.empty())
+        throw runtime_error("OT extension communication failed: " + error);
 }
 
 void OTExtensionWithMatrix::transpose(int start, int slice)
@@ -9,6 +9,7 @@
 #include "OTExtension.h"
 #include "BitMatrix.h"
 #include "Math/gf2n.h"
+#include "Tools/Worker.h"
 
 template <class U>
 class OTCorrelator : public OTExtension
@@ -46,12 +47,40 @@ public:
             U& baseReceiverOutput);
     template <class T>
     void correlate(int start, int slice, BitVector& newReceiverInput, bool useConstantBase, int repeat = 1);
+    // correlation split around communication for pipelining
+    template <class T>
+    void prepare_correlation(int start, int slice, vector<octetStream>& os,
+            BitVector& newReceiverInput, int repeat = 1);
+    template <class T>
+    void finish_correlation(int start, int slice, vector<octetStream>& os,
+            bool useConstantBase);
     template <class T>
     void reduce_squares(unsigned int nTriples, vector<T>& output);
 };
 
+// correlation communication of one slice to run by a worker in the background
+class CorrelationExchange
+{
+    TwoPartyPlayer* player;
+    vector<octetStream>* os;
+    OT_ROLE role;
+    string error;
+
+public:
+    void start(Worker<CorrelationExchange>& worker, TwoPartyPlayer* player,
+            vector<octetStream>& os, OT_ROLE role);
+    void wait(Worker<CorrelationExchange>& worker);
+    int run();
+};
+
 class OTExtensionWithMatrix : public OTCorrelator<BitMatrix>
 {
+    // setting to compare with the other party, -1 for none
+    int agreement;
+    string disagreement;
+
+    void check_agreement(octetStream& os);
+
 public:
     PRNG G;
 
@@ -67,12 +96,18 @@ public:
                 OT_ROLE role=BOTH,
                 bool passive=false)
     : OTCorrelator<BitMatrix>(nbaseOTs, baseLength, nloops, nsubloops, player, baseReceiverInput,
-            baseSenderInput, baseReceiverOutput, role, passive) {
+            baseSenderInput, baseReceiverOutput, role, passive),
+            agreement(-1) {
       G.ReSeed();
     }
 
     OTExtensionWithMatrix(BaseOT& baseOT, TwoPartyPlayer* player, bool passive);
 
+    // compare a setting of up to seven bits with the other party
+    // along with the first slice of the next extension, which saves a
+    // round, and throw error if they differ
+    void agree_on(int value, const string& error);
+
     void seed(vector<BitMatrix>& baseSenderInput,
             BitMatrix& baseReceiverOutput);
     void transfer(int nOTs, const BitVector& receiverInput);
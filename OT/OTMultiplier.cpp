@@ -24,10 +24,11 @@ template<class T>
 OTMultiplier<T>::OTMultiplier(OTTripleGenerator<T>& generator,
         int thread_num) :
         generator(generator), thread_num(thread_num),
-        rot_ext(128, 128, 0, 1,
+        rot_ext(128, 128, 0, OT_EXTENSION_SLICES,
                 generator.players[thread_num], generator.baseReceiverInput,
                 generator.baseSenderInputs[thread_num],
                 generator.baseReceiverOutputs[thread_num], BOTH, !generator.machine.check),
+        silent_ot(rot_ext, generator.players[thread_num], !generator.machine.check),
         otCorrelator(0, 0, 0, 0, generator.players[thread_num], {}, {}, {}, BOTH, true)
 {
     this->thread = 0;
@@ -71,6 +72,9 @@ OTMultiplier<T>::~OTMultiplier()
 template<class T>
 void OTMultiplier<T>::multiply()
 {
+    // both parties have to produce the correlations the same way
+    rot_ext.agree_on(generator.machine.silent_ot,
+            "parties disagree on silent OT (-V)");
     keyBits.set(generator.machine.template get_mac_key<typename T::mac_key_type>());
     rot_ext.extend<gf2n_long>(keyBits.size(), keyBits);
     this->outbox.push({});
@@ -143,7 +147,10 @@ void OTMultiplier<W>::multiplyForTriples()
         this->inbox.pop(job);
         BitVector aBits = generator.valueBits[0];
         //timers["Extension"].start();
-        rot_ext.extend_correlated(aBits);
+        if (generator.machine.silent_ot)
+            silent_ot.extend_correlated(aBits);
+        else
+            rot_ext.extend_correlated(aBits);
         rot_ext.hash_outputs<T>(aBits.size(), baseSenderOutputs, baseReceiverOutput);
         //timers["Extension"].stop();
 
@@ -10,6 +10,7 @@
 using namespace std;
 
 #include "OT/OTExtensionWithMatrix.h"
+#include "OT/SilentOT.h"
 #include "OT/OTVole.h"
 #include "OT/Rectangle.h"
 #include "Tools/random.h"
@@ -71,6 +72,7 @@ public:
     OTTripleGenerator<T>& generator;
     int thread_num;
     OTExtensionWithMatrix rot_ext;
+    SilentOT silent_ot;
 
     OTCorrelator<Matrix<typename T::Rectangle> > otCorrelator;
 
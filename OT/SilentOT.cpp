@@ -0,0 +1,271 @@
+/*
+ * SilentOT.cpp
+ *
+ */
+
+#include "SilentOT.h"
+#include "Math/gf2nlong.h"
+
+SilentOT::SilentOT(OTExtensionWithMatrix& ext, TwoPartyPlayer* player,
+        bool passive) :
+        ext(ext), player(player), passive(passive), n_available(0),
+        cheat(false)
+{
+    G.ReSeed();
+    // fixed keys for the GGM trees, known to both parties
+    for (int i = 0; i < 2; i++)
+    {
+        octet key[AES_BLK_SIZE] = {};
+        key[0] = 0x47 + i;
+        aes_128_schedule(keys[i], key);
+    }
+}
+
+void SilentOT::bootstrap()
+{
+    BitVector choices(N_BASE);
+    choices.randomize(G);
+    ext.extend_correlated(choices);
+    delta = ext.baseReceiverInput.get_int128(0);
+
+    bits.resize(N_BASE);
+    receiver_outputs.resize(N_BASE);
+    sender_outputs.resize(N_BASE);
+    for (int i = 0; i < N_BASE; i++)
+    {
+        bits.set_bit(i, choices.get_bit(i));
+        receiver_outputs[i] = ext.receiverOutputMatrix[i];
+        sender_outputs[i] = ext.senderOutputMatrices[0][i];
+    }
+}
+
+void SilentOT::expand_level(int128* children, const int128* parents,
+        int n_parents)
+{
+    // Matyas-Meyer-Oseas with one key per side
+    const int N_BLOCKS = 8;
+    for (int i = 0; i < n_parents; i += N_BLOCKS)
+    {
+        int n = min(N_BLOCKS, n_parents - i);
+        __m128i in[N_BLOCKS] = {}, out[N_BLOCKS];
+        for (int j = 0; j < n; j++)
+            in[j] = parents[i + j].a;
+        for (int k = 0; k < 2; k++)
+        {
+            ecb_aes_128_encrypt<N_BLOCKS>(out, in, keys[k]);
+            for (int j = 0; j < n; j++)
+                children[2 * (i + j) + k] = out[j] ^ in[j];
+        }
+    }
+}
+
+int128 SilentOT::hash(int128 x)
+{
+    int128 res;
+    mmo.hashOneBlock<gf2n_long>(&res, &x);
+    return res;
+}
+
+void SilentOT::expand()
+{
+    vector<int128> sender_leaves(N), receiver_leaves(N);
+    vector<int> alphas(N_TREES);
+    vector<int128> tree(LEAVES), tmp(LEAVES);
+    vector<octetStream> os(2);
+
+    // trees for own delta: the other party learns the sums of the
+    // sides that are not on its path
+    for (int t = 0; t < N_TREES; t++)
+    {
+        G.get_octets((octet*) &tree[0], sizeof(tree[0]));
+        for (int l = 0; l < DEPTH; l++)
+        {
+            expand_level(&tmp[0], &tree[0], 1 << l);
+            swap(tree, tmp);
+            int128 sums[2];
+            for (int j = 0; j < 2 << l; j++)
+                sums[j % 2] ^= tree[j];
+            int128 q = sender_outputs[K + t * DEPTH + l];
+            for (int b = 0; b < 2; b++)
+            {
+                int128 mask = hash(b ? q ^ delta : q);
+                sums[b] ^= mask;
+                os[0].append((octet*) &sums[b], sizeof(sums[b]));
+            }
+        }
+        int128 sum = delta;
+        for (int j = 0; j < LEAVES; j++)
+        {
+            sum ^= tree[j];
+            sender_leaves[t * LEAVES + j] = tree[j];
+        }
+        if (cheat and t == 0)
+            sum ^= int128(1);
+        os[0].append((octet*) &sum, sizeof(sum));
+    }
+
+    player->send_receive_player(os);
+
+    // trees for the other delta punctured at the path given by the
+    // choice bits, where the path node is marked by zero
+    for (int t = 0; t < N_TREES; t++)
+    {
+        int alpha = 0;
+        tree[0] = {};
+        for (int l = 0; l < DEPTH; l++)
+        {
+            expand_level(&tmp[0], &tree[0], 1 << l);
+            swap(tree, tmp);
+            int i = K + t * DEPTH + l;
+            int b = bits.get_bit(i);
+            int128 sums[2];
+            for (int k = 0; k < 2; k++)
+                os[1].consume((octet*) &sums[k], sizeof(sums[k]));
+            int128 sibling = sums[b] ^ hash(receiver_outputs[i]);
+            int path = 2 * alpha + 1 - b;
+            tree[path] = tree[2 * alpha + b] = {};
+            for (int j = b; j < 2 << l; j += 2)
+                sibling ^= tree[j];
+            tree[2 * alpha + b] = sibling;
+            alpha = path;
+        }
+        int128 sum;
+        os[1].consume((octet*) &sum, sizeof(sum));
+        for (int j = 0; j < LEAVES; j++)
+            sum ^= tree[j];
+        tree[alpha] = sum;
+        for (int j = 0; j < LEAVES; j++)
+            receiver_leaves[t * LEAVES + j] = tree[j];
+        alphas[t] = alpha;
+    }
+
+    if (not passive)
+        check(sender_leaves, receiver_leaves, alphas);
+
+    // add the code applied to the base correlations at the beginning,
+    // which are replaced by the first outputs
+    BitVector new_bits(N);
+    octet seed[SEED_SIZE] = {};
+    PRNG code;
+    code.SetSeed(seed);
+    for (int j = 0; j < N; j++)
+    {
+        int bit = j % LEAVES == alphas[j / LEAVES];
+        for (int k = 0; k < D; k++)
+        {
+            int i = code.get_uint(K);
+            bit ^= bits.get_bit(i);
+            receiver_leaves[j] ^= receiver_outputs[i];
+            sender_leaves[j] ^= sender_outputs[i];
+        }
+        new_bits.set_bit(j, bit);
+    }
+
+    bits = new_bits;
+    receiver_outputs.swap(receiver_leaves);
+    sender_outputs.swap(sender_leaves);
+    n_available = N - N_BASE;
+}
+
+void SilentOT::check(const vector<int128>& sender_leaves,
+        const vector<int128>& receiver_leaves, const vector<int>& alphas)
+{
+    // random linear combination over GF(2)[X] without reduction like
+    // in OTExtension::check_correlation(), using the last 128 base
+    // correlations as one correlation of a polynomial
+    int base = K + N_TREES * DEPTH;
+    vector<octetStream> os(2);
+    __m128i tmp[2];
+
+    // challenge chosen by the receiver after the trees are fixed
+    octet seed[SEED_SIZE];
+    G.get_octets(seed, SEED_SIZE);
+    PRNG chi;
+    chi.SetSeed(seed);
+    __m128i W[2] = {}, x_star = {};
+    int128 chi_alpha;
+    for (int j = 0; j < N; j++)
+    {
+        __m128i x;
+        chi.get_octets((octet*) &x, sizeof(x));
+        mul128(x, receiver_leaves[j].a, &tmp[0], &tmp[1]);
+        for (int k = 0; k < 2; k++)
+            W[k] ^= tmp[k];
+        if (j % LEAVES == alphas[j / LEAVES])
+            chi_alpha ^= x;
+    }
+    for (int j = 0; j < 128; j++)
+    {
+        mul128(receiver_outputs[base + j].a, (int128(1) << j).a, &tmp[0],
+                &tmp[1]);
+        for (int k = 0; k < 2; k++)
+            W[k] ^= tmp[k];
+        if (bits.get_bit(base + j))
+            x_star ^= (int128(1) << j).a;
+    }
+    int128 x_prime = chi_alpha ^ x_star;
+    os[0].append(seed, SEED_SIZE);
+    os[0].append((octet*) &x_prime, sizeof(x_prime));
+    player->send_receive_player(os);
+
+    // sender answers with a hash to hide delta from a cheating receiver
+    os[1].consume(seed, SEED_SIZE);
+    os[1].consume((octet*) &x_prime, sizeof(x_prime));
+    chi.SetSeed(seed);
+    __m128i V[2];
+    mul128(x_prime.a, delta.a, &V[0], &V[1]);
+    for (int j = 0; j < N; j++)
+    {
+        __m128i x;
+        chi.get_octets((octet*) &x, sizeof(x));
+        mul128(x, sender_leaves[j].a, &tmp[0], &tmp[1]);
+        for (int k = 0; k < 2; k++)
+            V[k] ^= tmp[k];
+    }
+    for (int j = 0; j < 128; j++)
+    {
+        mul128(sender_outputs[base + j].a, (int128(1) << j).a, &tmp[0],
+                &tmp[1]);
+        for (int k = 0; k < 2; k++)
+            V[k] ^= tmp[k];
+    }
+    octetStream mine, theirs;
+    mine.append((octet*) V, sizeof(V));
+    theirs.append((octet*) W, sizeof(W));
+    os[0] = mine.hash();
+    player->send_receive_player(os);
+    if (not (os[1] == theirs.hash()))
+        throw runtime_error("silent OT consistency check");
+}
+
+void SilentOT::extend_correlated(BitVector& newReceiverInput)
+{
+    if (bits.size() == 0)
+        bootstrap();
+
+    int n = newReceiverInput.size();
+    ext.resize(DIV_CEIL(n, 128) * 128);
+
+    // choice bits are random, so the receiver sends the difference
+    // and the sender adds delta accordingly
+    vector<octetStream> os(2);
+    BitVector diff(n);
+    for (int i = 0; i < n; i++)
+    {
+        if (n_available == 0)
+            expand();
+        int j = N - n_available--;
+        diff.set_bit(i, newReceiverInput.get_bit(i) ^ bits.get_bit(j));
+        ext.receiverOutputMatrix.squares[i / 128].rows[i % 128] =
+                receiver_outputs[j].a;
+        ext.senderOutputMatrices[0].squares[i / 128].rows[i % 128] =
+                sender_outputs[j].a;
+    }
+    diff.pack(os[0]);
+    player->send_receive_player(os);
+    diff.unpack(os[1]);
+    for (int i = 0; i < n; i++)
+        if (diff.get_bit(i))
+            ext.senderOutputMatrices[0].squares[i / 128].rows[i % 128] ^=
+                    delta.a;
+}
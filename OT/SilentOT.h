@@ -0,0 +1,68 @@
+/*
+ * SilentOT.h
+ *
+ */
+
+#ifndef OT_SILENTOT_H_
+#define OT_SILENTOT_H_
+
+#include "OTExtensionWithMatrix.h"
+#include "Tools/MMO.h"
+
+/*
+ * Correlated OT by LPN expansion (Ferret, Yang et al., CCS 2020).
+ * Every iteration turns N_BASE correlations into N: one GGM tree per
+ * noise block gives a regular sparse correlation, which is added to a
+ * local linear code applied to the first K base correlations.
+ * Communication is linear in the number of trees, not in N.
+ * The first base correlations come from OT extension, later ones are
+ * reserved from the previous iteration.
+ */
+class SilentOT
+{
+    // regular LPN parameters of the Ferret setup phase
+    static const int N = 470016;
+    static const int K = 32768;
+    static const int N_TREES = 918;
+    static const int DEPTH = 9;
+    static const int LEAVES = 1 << DEPTH;
+    // non-zero entries per column of the code
+    static const int D = 10;
+    // for the LPN input, the trees, and the consistency check
+    static const int N_BASE = K + N_TREES * DEPTH + 128;
+
+    OTExtensionWithMatrix& ext;
+    TwoPartyPlayer* player;
+    bool passive;
+    PRNG G;
+    MMO mmo;
+    octet keys[2][176] __attribute__((aligned (16)));
+
+    int128 delta;
+
+    // receiver outputs t = q + bits * delta (other party's delta)
+    BitVector bits;
+    vector<int128> receiver_outputs;
+    // sender outputs q (own delta)
+    vector<int128> sender_outputs;
+    // outputs not yet used, base correlations excluded
+    size_t n_available;
+
+    void bootstrap();
+    void expand();
+    void expand_level(int128* children, const int128* parents, int n_parents);
+    int128 hash(int128 x);
+    void check(const vector<int128>& sender_leaves,
+            const vector<int128>& receiver_leaves, const vector<int>& alphas);
+
+public:
+    // corrupt the first tree to test the consistency check
+    bool cheat;
+
+    SilentOT(OTExtensionWithMatrix& ext, TwoPartyPlayer* player, bool passive);
+
+    // same outputs as OTExtensionWithMatrix::extend_correlated()
+    void extend_correlated(BitVector& newReceiverInput);
+};
+
+#endif /* OT_SILENTOT_H_ */
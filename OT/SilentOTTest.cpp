@@ -0,0 +1,127 @@
+/*
+ * SilentOTTest.cpp
+ *
+ */
+
+#include "SilentOT.h"
+#include "Networking/Player.h"
+
+#include <iostream>
+#include <thread>
+#include <stdexcept>
+#include <stdlib.h>
+using namespace std;
+
+/*
+ * Runs one party of silent OT with base OTs from a common seed and
+ * checks t = q + c * delta against the outputs of the other party.
+ */
+void run(int my_num, bool passive, int n_rounds, int n_ots, int& n_errors,
+        bool cheat)
+{
+    Names N(my_num, 14000 + 10 * passive + 20 * cheat,
+            vector<string>({"localhost", "localhost"}));
+    RealTwoPartyPlayer P(N, 1 - my_num, 0);
+
+    // fake base OTs known to both parties
+    PRNG common;
+    octet seed[SEED_SIZE] = {};
+    common.SetSeed(seed);
+    BitVector deltas[2];
+    vector<vector<BitVector>> messages[2];
+    for (int i = 0; i < 2; i++)
+    {
+        deltas[i].resize(128);
+        deltas[i].randomize(common);
+        messages[i].resize(128, vector<BitVector>(2, BitVector(128)));
+        for (auto& x : messages[i])
+            for (auto& y : x)
+                y.randomize(common);
+    }
+    vector<BitVector> received(128);
+    for (int i = 0; i < 128; i++)
+        received[i] = messages[my_num][i][deltas[my_num].get_bit(i)];
+    OTExtensionWithMatrix ext(128, 128, 0, 1, &P, deltas[my_num],
+            messages[1 - my_num], received, BOTH, passive);
+    SilentOT silent_ot(ext, &P, passive);
+
+    // party 0 corrupts a tree, which party 1 has to notice
+    if (cheat)
+    {
+        silent_ot.cheat = my_num == 0;
+        BitVector choices(n_ots);
+        n_errors = my_num;
+        try
+        {
+            silent_ot.extend_correlated(choices);
+        }
+        catch (runtime_error& e)
+        {
+            if (string(e.what()) == "silent OT consistency check")
+                n_errors = 0;
+            // the cheater does not notice and expects the choice bits
+            vector<octetStream> os(2);
+            choices.pack(os[0]);
+            P.send_receive_player(os);
+        }
+        return;
+    }
+
+    PRNG G;
+    G.ReSeed();
+    n_errors = 0;
+    for (int k = 0; k < n_rounds; k++)
+    {
+        BitVector choices(n_ots);
+        choices.randomize(G);
+        silent_ot.extend_correlated(choices);
+
+        vector<octetStream> os(2);
+        ext.baseReceiverInput.pack(os[0]);
+        for (int i = 0; i < n_ots; i++)
+            os[0].append((octet*) &ext.senderOutputMatrices[0].squares[i / 128].rows[i % 128],
+                    sizeof(__m128i));
+        P.send_receive_player(os);
+        BitVector delta(128);
+        delta.unpack(os[1]);
+        for (int i = 0; i < n_ots; i++)
+        {
+            int128 q, t = ext.receiverOutputMatrix.squares[i / 128].rows[i % 128];
+            os[1].consume((octet*) &q, sizeof(q));
+            if (choices.get_bit(i))
+                q ^= delta.get_int128(0);
+            if (t != q)
+                n_errors++;
+        }
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    // several expansions of about 430,000 OTs each
+    int n_rounds = argc > 1 ? atoi(argv[1]) : 4;
+    int n_ots = argc > 2 ? atoi(argv[2]) : 300000;
+
+    int total = 0;
+    for (bool passive : {true, false})
+    {
+        int n_errors[2];
+        thread other(run, 1, passive, n_rounds, n_ots, ref(n_errors[1]),
+                false);
+        run(0, passive, n_rounds, n_ots, n_errors[0], false);
+        other.join();
+        cout << (passive ? "Passive" : "Active") << ": "
+                << n_errors[0] + n_errors[1] << " errors in "
+                << 2 * n_rounds * n_ots << " OTs" << endl;
+        total += n_errors[0] + n_errors[1];
+    }
+
+    int n_errors[2];
+    thread other(run, 1, false, 1, n_ots, ref(n_errors[1]), true);
+    run(0, false, 1, n_ots, n_errors[0], true);
+    other.join();
+    cout << "Cheating " << (n_errors[1] ? "not " : "") << "detected" << endl;
+    total += n_errors[1];
+    if (total)
+        exit(1);
+}
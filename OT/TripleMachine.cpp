@@ -31,6 +31,7 @@ MascotParams::MascotParams()
     amplify = true;
     check = true;
     generateBits = false;
+    silent_ot = false;
     timerclear(&start);
 }
 
@@ -27,6 +27,7 @@ public:
     bool amplify;
     bool check;
     bool generateBits;
+    bool silent_ot;
     struct timeval start, stop;
 
     MascotParams();
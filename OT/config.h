@@ -9,4 +9,8 @@
 #define USE_OPT_VOLE 1
 #define NUM_VOLE_CHALLENGES 3
 
+// slices in the OT extension for triple generation,
+// communication of one slice overlaps with computation on the others
+#define OT_EXTENSION_SLICES 4
+
 #endif /* OT_CONFIG_H_ */
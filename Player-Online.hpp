@@ -11,8 +11,28 @@
 #include <stdio.h>
 using namespace std;
 
+/*
+ * Work in the same process as the online phase,
+ * for example producing preprocessing data.
+ */
+template<class T>
+class OnlineCompanion
+{
+public:
+    virtual ~OnlineCompanion() {}
+    // before the online machine starts its threads,
+    // initializes the fields and provides the MAC key instead of Player-Data
+    virtual void setup(Names& N, int lgp, int lg2,
+            typename T::mac_key_type& mac_key) = 0;
+    // after the online setup, before running the program
+    virtual void start() = 0;
+    // after all online threads have finished
+    virtual void stop() = 0;
+};
+
 template<class T, class U>
-int spdz_main(int argc, const char** argv, ez::ezOptionParser& opt)
+int spdz_main(int argc, const char** argv, ez::ezOptionParser& opt,
+        OnlineCompanion<T>* companion = 0)
 {
     OnlineOptions online_opts(opt, argc, argv);
 
@@ -212,11 +232,27 @@ int spdz_main(int argc, const char** argv, ez::ezOptionParser& opt)
     try
 #endif
     {
-        Machine<T, U>(playerno, playerNames, online_opts.progname, memtype, lg2,
-                opt.get("--direct")->isSet, opening_sum, opt.get("--parallel")->isSet,
-                opt.get("--threads")->isSet, max_broadcast,
-                opt.get("--encrypted")->isSet, online_opts.live_prep,
-                online_opts).run();
+        typename T::mac_key_type mac_key;
+        if (companion)
+        {
+            // data from Player-Data would use a different MAC key
+            if (not online_opts.live_prep)
+                throw runtime_error("in-process preprocessing "
+                        "cannot be combined with preprocessing from files");
+            companion->setup(playerNames, online_opts.lgp, lg2, mac_key);
+        }
+
+        Machine<T, U> machine(playerno, playerNames, online_opts.progname,
+                memtype, lg2, opt.get("--direct")->isSet, opening_sum,
+                opt.get("--parallel")->isSet, opt.get("--threads")->isSet,
+                max_broadcast, opt.get("--encrypted")->isSet,
+                online_opts.live_prep, online_opts, companion ? &mac_key : 0);
+
+        if (companion)
+            companion->start();
+        machine.run();
+        if (companion)
+            companion->stop();
 
         if (server)
           delete server;
@@ -0,0 +1,74 @@
+/*
+ * AsyncPrep.h
+ *
+ */
+
+#ifndef PROCESSOR_ASYNCPREP_H_
+#define PROCESSOR_ASYNCPREP_H_
+
+#include "ReplicatedPrep.h"
+#include "Tools/Signal.h"
+
+#include <deque>
+#include <exception>
+
+/*
+ * Runs the live preprocessing of type T in a background thread with
+ * its own player so that its communication does not interleave
+ * with the online protocol. The online thread only swaps in batches
+ * that have been produced in advance.
+ */
+template<class T>
+class AsyncPrep : public BufferPrep<T>
+{
+    typedef BufferPrep<T> super;
+
+    static const int STOP = 1 << 7;
+
+    SubProcessor<T>* proc;
+
+    pthread_t thread;
+    bool started;
+
+    Signal signal;
+    bool stopping;
+    bool requested[N_DTYPE];
+    exception_ptr error;
+    size_t sent;
+
+    deque<vector<array<T, 3>>> triple_queue;
+    deque<vector<array<T, 2>>> square_queue;
+    deque<vector<array<T, 2>>> inverse_queue;
+    deque<vector<T>> bit_queue;
+
+    static void* run_thread(void* prep);
+
+    void start();
+    void run();
+    void produce(Player& P, BufferPrep<T>& prep);
+
+    int n_ready(Dtype dtype);
+    int wanted();
+
+    template<class U>
+    void fetch(deque<U>& queue, U& buffer, Dtype dtype);
+
+    void buffer_triples() { fetch(triple_queue, this->triples, DATA_TRIPLE); }
+    void buffer_squares() { fetch(square_queue, this->squares, DATA_SQUARE); }
+    void buffer_inverses() { fetch(inverse_queue, this->inverses, DATA_INVERSE); }
+    void buffer_bits() { fetch(bit_queue, this->bits, DATA_BIT); }
+
+public:
+    // number of batches per type to keep ready in addition to the one in use
+    int n_batches;
+
+    AsyncPrep(DataPositions& usage);
+    ~AsyncPrep();
+
+    void set_proc(SubProcessor<T>* proc) { this->proc = proc; }
+    void set_protocol(typename T::Protocol& protocol) { (void) protocol; }
+
+    size_t data_sent();
+};
+
+#endif /* PROCESSOR_ASYNCPREP_H_ */
@@ -0,0 +1,229 @@
+/*
+ * AsyncPrep.hpp
+ *
+ */
+
+#include "AsyncPrep.h"
+#include "Processor/Processor.h"
+#include "Networking/CryptoPlayer.h"
+
+#include <memory>
+
+template<class T>
+AsyncPrep<T>::AsyncPrep(DataPositions& usage) :
+        BufferPrep<T>(usage), proc(0), started(false), stopping(false),
+        sent(0), n_batches(2)
+{
+    for (auto& x : requested)
+        x = false;
+}
+
+template<class T>
+AsyncPrep<T>::~AsyncPrep()
+{
+    if (started)
+    {
+        signal.lock();
+        stopping = true;
+        signal.broadcast();
+        signal.unlock();
+        pthread_join(thread, 0);
+    }
+}
+
+template<class T>
+void AsyncPrep<T>::start()
+{
+    assert(proc != 0);
+    started = true;
+    pthread_create(&thread, 0, run_thread, this);
+}
+
+template<class T>
+void* AsyncPrep<T>::run_thread(void* prep)
+{
+    ((AsyncPrep<T>*) prep)->run();
+    return 0;
+}
+
+template<class T>
+void AsyncPrep<T>::run()
+{
+    bigint::init_thread();
+
+    try
+    {
+        // same layout as mc_base_id() with an unused function id
+        int id = (4 << 28) + ((T::field_type() + 1) << 24)
+                + (proc->Proc.thread_num << 16);
+        // deleting the player on errors closes the connections,
+        // which stops the other parties from waiting for this one
+        unique_ptr<Player> P;
+        if (proc->P.is_encrypted())
+            P.reset(new CryptoPlayer(proc->P.N, id));
+        else
+            P.reset(new PlainPlayer(proc->P.N, id));
+
+        ArithmeticProcessor Proc(proc->Proc.opts, proc->Proc.thread_num);
+        typename T::MAC_Check MC(proc->MC.get_alphai());
+        DataPositions usage(P->num_players());
+        unique_ptr<Preprocessing<T>> prep(
+                Preprocessing<T>::get_live_prep(0, usage));
+        SubProcessor<T> subproc(Proc, MC, *prep, *P);
+        auto buffer_prep = dynamic_cast<BufferPrep<T>*>(prep.get());
+        if (buffer_prep == 0)
+            throw runtime_error("background preprocessing not supported");
+        buffer_prep->buffer_size = this->buffer_size;
+
+        produce(*P, *buffer_prep);
+
+        MC.Check(*P);
+    }
+    catch (...)
+    {
+        // rethrown on the online thread by fetch()
+        signal.lock();
+        error = current_exception();
+        signal.broadcast();
+        signal.unlock();
+    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    OPENSSL_thread_stop();
+#endif
+}
+
+template<class T>
+void AsyncPrep<T>::produce(Player& P, BufferPrep<T>& prep)
+{
+    int next = 0;
+
+    while (true)
+    {
+        // only talk to the other parties if there is something to do
+        signal.lock();
+        while (not stopping and wanted() == 0)
+            signal.wait();
+        int mine = stopping ? STOP : wanted();
+        signal.unlock();
+
+        // all parties have to produce the same type of data,
+        // so every party produces what at least one party needs
+        vector<octetStream> os(P.num_players());
+        os[P.my_num()].store_int(mine, 1);
+        P.Broadcast_Receive(os, true);
+        int all = 0;
+        for (auto& o : os)
+            all |= o.get_int(1);
+
+        if (all & STOP)
+            return;
+        if (not (all & ((1 << DATA_BITTRIPLE) - 1)))
+            continue;
+
+        int dtype;
+        do
+            dtype = next++ % DATA_BITTRIPLE;
+        while (not (all & (1 << dtype)));
+
+        switch (dtype)
+        {
+        case DATA_TRIPLE:
+            prep.buffer_triples();
+            break;
+        case DATA_SQUARE:
+            prep.buffer_squares();
+            break;
+        case DATA_BIT:
+            prep.buffer_bits();
+            break;
+        case DATA_INVERSE:
+            prep.buffer_inverses();
+            break;
+        }
+
+        signal.lock();
+        switch (dtype)
+        {
+        case DATA_TRIPLE:
+            triple_queue.push_back({});
+            triple_queue.back().swap(prep.triples);
+            break;
+        case DATA_SQUARE:
+            square_queue.push_back({});
+            square_queue.back().swap(prep.squares);
+            break;
+        case DATA_BIT:
+            bit_queue.push_back({});
+            bit_queue.back().swap(prep.bits);
+            break;
+        case DATA_INVERSE:
+            inverse_queue.push_back({});
+            inverse_queue.back().swap(prep.inverses);
+            break;
+        }
+        sent = P.sent + prep.data_sent();
+        signal.broadcast();
+        signal.unlock();
+    }
+}
+
+template<class T>
+int AsyncPrep<T>::n_ready(Dtype dtype)
+{
+    switch (dtype)
+    {
+    case DATA_TRIPLE:
+        return triple_queue.size();
+    case DATA_SQUARE:
+        return square_queue.size();
+    case DATA_BIT:
+        return bit_queue.size();
+    case DATA_INVERSE:
+        return inverse_queue.size();
+    default:
+        return 0;
+    }
+}
+
+template<class T>
+int AsyncPrep<T>::wanted()
+{
+    int res = 0;
+    for (int dtype = 0; dtype < DATA_BITTRIPLE; dtype++)
+        if (requested[dtype] and n_ready(Dtype(dtype)) < n_batches)
+            res |= 1 << dtype;
+    return res;
+}
+
+template<class T>
+template<class U>
+void AsyncPrep<T>::fetch(deque<U>& queue, U& buffer, Dtype dtype)
+{
+    if (not started)
+        start();
+
+    signal.lock();
+    requested[dtype] = true;
+    signal.broadcast();
+    while (queue.empty() and not error)
+        signal.wait();
+    if (error)
+    {
+        signal.unlock();
+        rethrow_exception(error);
+    }
+    buffer.swap(queue.front());
+    queue.pop_front();
+    signal.broadcast();
+    signal.unlock();
+}
+
+template<class T>
+size_t AsyncPrep<T>::data_sent()
+{
+    signal.lock();
+    size_t res = sent;
+    signal.unlock();
+    return res;
+}
@@ -26,6 +26,8 @@ class Beaver : public ProtocolBase<T>
     typename vector<array<T, 3>>::iterator triple;
     SubProcessor<T>* proc;
 
+    T finalize_mul(array<T, 3>& triple, const typename T::open_type* opened);
+
 public:
     Player& P;
 
@@ -36,6 +38,11 @@ public:
     void exchange();
     T finalize_mul();
 
+    // bulk versions fetching all triples at once
+    void muls(const vector<int>& reg, SubProcessor<T>& proc,
+            typename T::MAC_Check& MC, int size);
+    void dotprods(const vector<int>& reg, SubProcessor<T>& proc);
+
     int get_n_relevant_players() { return P.num_players(); }
 };
 
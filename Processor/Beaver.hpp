@@ -38,15 +38,112 @@ void Beaver<T>::exchange()
 
 template<class T>
 T Beaver<T>::finalize_mul()
+{
+    T res = finalize_mul(*triple++, &*it);
+    it += 2;
+    return res;
+}
+
+template<class T>
+inline T Beaver<T>::finalize_mul(array<T, 3>& triple,
+        const typename T::open_type* opened)
 {
     typename T::clear masked[2];
-    T& tmp = (*triple)[2];
+    T& tmp = triple[2];
     for (int k = 0; k < 2; k++)
     {
-        masked[k] = *it++;
-        tmp += (masked[k] * (*triple)[1 - k]);
+        masked[k] = opened[k];
+        tmp += (masked[k] * triple[1 - k]);
     }
     tmp.add(tmp, masked[0] * masked[1], P.my_num(), proc->MC.get_alphai());
-    triple++;
     return tmp;
 }
+
+template<class T>
+void Beaver<T>::muls(const vector<int>& reg, SubProcessor<T>& proc,
+        typename T::MAC_Check& MC, int size)
+{
+    assert(reg.size() % 3 == 0);
+    int n = reg.size() / 3;
+    int n_mults = n * size;
+    this->proc = &proc;
+
+    proc.DataF.get_triples(triples, n_mults);
+    shares.resize(2 * n_mults);
+    auto triple = triples.begin();
+    auto share = shares.begin();
+    for (int i = 0; i < n; i++)
+    {
+        auto x = proc.S.begin() + reg[3 * i + 1];
+        auto y = proc.S.begin() + reg[3 * i + 2];
+        for (int j = 0; j < size; j++)
+        {
+            *share++ = x[j] - (*triple)[0];
+            *share++ = y[j] - (*triple)[1];
+            triple++;
+        }
+    }
+
+    MC.POpen(opened, shares, P);
+
+    triple = triples.begin();
+    auto masked = opened.data();
+    for (int i = 0; i < n; i++)
+    {
+        auto z = proc.S.begin() + reg[3 * i];
+        for (int j = 0; j < size; j++)
+        {
+            z[j] = finalize_mul(*triple++, masked);
+            masked += 2;
+        }
+    }
+
+    this->counter += n_mults;
+}
+
+template<class T>
+void Beaver<T>::dotprods(const vector<int>& reg, SubProcessor<T>& proc)
+{
+    this->proc = &proc;
+
+    int n_mults = 0;
+    for (auto it = reg.begin(); it != reg.end(); it += *it)
+        n_mults += (*it - 2) / 2;
+
+    proc.DataF.get_triples(triples, n_mults);
+    shares.resize(2 * n_mults);
+    auto triple = triples.begin();
+    auto share = shares.begin();
+    auto it = reg.begin();
+    while (it != reg.end())
+    {
+        auto next = it + *it;
+        it += 2;
+        for (; it != next; it += 2)
+        {
+            *share++ = proc.S[*it] - (*triple)[0];
+            *share++ = proc.S[*(it + 1)] - (*triple)[1];
+            triple++;
+        }
+    }
+
+    proc.MC.POpen(opened, shares, P);
+
+    triple = triples.begin();
+    auto masked = opened.data();
+    it = reg.begin();
+    while (it != reg.end())
+    {
+        auto next = it + *it;
+        T res;
+        for (auto x = it + 2; x != next; x += 2)
+        {
+            res += finalize_mul(*triple++, masked);
+            masked += 2;
+        }
+        proc.S[*(it + 1)] = res;
+        it = next;
+    }
+
+    this->counter += n_mults;
+}
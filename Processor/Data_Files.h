@@ -16,6 +16,7 @@
 
 #include <fstream>
 #include <map>
+#include <array>
 using namespace std;
 
 class DataTag
@@ -74,7 +75,7 @@ class Preprocessing
 {
   DataPositions& usage;
 
-  void count(Dtype dtype) { usage.files[T::field_type()][dtype]++; }
+  void count(Dtype dtype, int n = 1) { usage.files[T::field_type()][dtype] += n; }
   void count(DataTag tag, int n = 1) { usage.extended[T::field_type()][tag] += n; }
   void count_input(int player) { usage.inputs[player][T::field_type()]++; }
 
@@ -103,6 +104,7 @@ public:
   virtual void get_input_no_count(T& a, typename T::open_type& x, int i) = 0;
   virtual void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs,
       int vector_size) = 0;
+  virtual void get_triples_no_count(vector<array<T, 3>>& triples, int n);
 
   void get(Dtype dtype, T* a);
   void get_three(Dtype dtype, T& a, T& b, T& c);
@@ -110,6 +112,8 @@ public:
   void get_one(Dtype dtype, T& a);
   void get_input(T& a, typename T::open_type& x, int i);
   void get(vector<T>& S, DataTag tag, const vector<int>& regs, int vector_size);
+  // replaces content of triples by n triples
+  void get_triples(vector<array<T, 3>>& triples, int n);
 };
 
 template<class T>
@@ -181,6 +185,8 @@ public:
       input_buffers[i].input(a);
   }
 
+  void get_triples_no_count(vector<array<T, 3>>& triples, int n);
+
   void setup_extended(const DataTag& tag, int tuple_size = 0);
   void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs, int vector_size);
 };
@@ -231,8 +237,7 @@ bool Sub_Data_Files<T>::input_eof(int player)
 template<class T>
 inline void Sub_Data_Files<T>::get_no_count(Dtype dtype, T* a)
 {
-  for (int i = 0; i < DataPositions::tuple_size[dtype]; i++)
-    buffers[dtype].input(a[i]);
+  buffers[dtype].input(a, DataPositions::tuple_size[dtype]);
 }
 
 template<class T>
@@ -291,6 +296,22 @@ inline void Preprocessing<T>::get(vector<T>& S, DataTag tag,
   get_no_count(S, tag, regs, vector_size);
 }
 
+template<class T>
+void Preprocessing<T>::get_triples_no_count(vector<array<T, 3>>& triples,
+    int n)
+{
+  triples.resize(n);
+  for (auto& triple : triples)
+    get_three_no_count(DATA_TRIPLE, triple[0], triple[1], triple[2]);
+}
+
+template<class T>
+inline void Preprocessing<T>::get_triples(vector<array<T, 3>>& triples, int n)
+{
+  count(DATA_TRIPLE, n);
+  get_triples_no_count(triples, n);
+}
+
 template<class sint, class sgf2n>
 inline void Data_Files<sint, sgf2n>::purge()
 {
@@ -5,6 +5,8 @@
 #include "Processor/MaliciousRepPrep.hpp"
 //#include "Processor/Replicated.hpp"
 #include "Processor/ReplicatedPrep.hpp"
+#include "Processor/AsyncPrep.hpp"
+#include "Processor/StreamPrep.hpp"
 //#include "Processor/Input.hpp"
 //#include "Processor/ReplicatedInput.hpp"
 //#include "Processor/Shamir.hpp"
@@ -28,10 +30,22 @@ Preprocessing<T>* Preprocessing<T>::get_new(
     Machine<U, V>& machine,
     DataPositions& usage, SubProcessor<T>* proc)
 {
+  Preprocessing<T>* res;
   if (machine.live_prep)
-    return get_live_prep(proc, usage);
+    {
+      // OT-based preprocessing depends on the order of the OT setups
+      if (machine.opts.async_prep and not T::needs_ot)
+        res = new AsyncPrep<T>(usage);
+      else
+        res = get_live_prep(proc, usage);
+    }
+  else
+    res = new Sub_Data_Files<T>(machine.get_N(), machine.prep_dir_prefix, usage);
+
+  if (StreamPrep<T>::active())
+    return new StreamPrep<T>(usage, *res);
   else
-    return new Sub_Data_Files<T>(machine.get_N(), machine.prep_dir_prefix, usage);
+    return res;
 }
 
 
@@ -168,7 +182,7 @@ void Sub_Data_Files<T>::prune()
   my_input_buffers.prune();
   for (int j = 0; j < num_players; j++)
     input_buffers[j].prune();
-  for (auto it : extended)
+  for (auto& it : extended)
     it.second.prune();
 }
 
@@ -187,14 +201,14 @@ void Sub_Data_Files<T>::purge()
   my_input_buffers.purge();
   for (int j = 0; j < num_players; j++)
     input_buffers[j].purge();
-  for (auto it : extended)
+  for (auto& it : extended)
     it.second.purge();
 }
 
 template<class T>
 void Sub_Data_Files<T>::setup_extended(const DataTag& tag, int tuple_size)
 {
-  BufferBase& buffer = extended[tag];
+  auto& buffer = extended[tag];
   tuple_lengths_lock.lock();
   int tuple_length = tuple_lengths[tag];
   int my_tuple_length = tuple_size * T::size();
@@ -221,6 +235,15 @@ void Sub_Data_Files<T>::setup_extended(const DataTag& tag, int tuple_size)
     }
 }
 
+template<class T>
+void Sub_Data_Files<T>::get_triples_no_count(vector<array<T, 3>>& triples,
+    int n)
+{
+  triples.resize(n);
+  if (n > 0)
+    buffers[DATA_TRIPLE].input(triples[0].data(), 3 * n);
+}
+
 template<class T>
 void Sub_Data_Files<T>::get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs, int vector_size)
 {
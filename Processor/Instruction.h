@@ -15,6 +15,7 @@ using namespace std;
 
 template<class sint, class sgf2n> class Machine;
 template<class sint, class sgf2n> class Processor;
+template<class T> class SubProcessor;
 
 /* 
  * Opcode constants
@@ -94,6 +95,7 @@ enum
     MULS = 0xA6,
     MULRS = 0xA7,
     DOTPRODS = 0xA8,
+    MATMULS = 0xAA,
     // Data access
     TRIPLE = 0x50,
     BIT = 0x51,
@@ -218,6 +220,7 @@ enum
     GMULS = 0x1A6,
     GMULRS = 0x1A7,
     GDOTPRODS = 0x1A8,
+    GMATMULS = 0x1AA,
     // Data access
     GTRIPLE = 0x150,
     GBIT = 0x151,
@@ -313,6 +316,11 @@ public:
 
   // Returns the maximal register used
   unsigned get_max_reg(int reg_type) const;
+
+  // Kinds of the registers in r[] ('s' for secret, 'c' for clear, 'i' for
+  // integer) if the instruction neither communicates nor uses
+  // preprocessing, 0 otherwise
+  const char* get_local_operands() const;
 };
 
 class DataPositions;
@@ -335,6 +343,13 @@ public:
   // and streams pointing to the triples etc
   template<class sint, class sgf2n>
   void execute(Processor<sint, sgf2n>& Proc) const;
+
+  // Execute with queueing of openings and multiplications
+  template<class sint, class sgf2n>
+  void execute_lazily(Processor<sint, sgf2n>& Proc) const;
+
+  template<class T>
+  void flush_if_dependent(SubProcessor<T>& proc, const char* operands) const;
 };
 
 
@@ -276,6 +276,11 @@ void BaseInstruction::parse_operands(istream& s, int pos)
       case PRINTFLOATPLAIN:
         get_vector(4, start, s);
         break;
+      // result and operand registers followed by dimensions
+      case MATMULS:
+      case GMATMULS:
+        get_vector(6, start, s);
+        break;
       // open instructions + read/write instructions with variable length args
       case WRITEFILESHARE:
       case OPEN:
@@ -469,6 +474,10 @@ unsigned BaseInstruction::get_max_reg(int reg_type) const
       }
       return res;
   }
+  case MATMULS:
+  case GMATMULS:
+      return max(start[0] + start[3] * start[5],
+          max(start[1] + start[3] * start[4], start[2] + start[4] * start[5]));
   }
 
   const int *begin, *end;
@@ -489,6 +498,145 @@ unsigned BaseInstruction::get_max_reg(int reg_type) const
   return res + size;
 }
 
+inline
+const char* BaseInstruction::get_local_operands() const
+{
+  switch (opcode)
+  {
+  case LDI:
+  case LDMC:
+  case STMC:
+  case INV2M:
+  case GLDI:
+  case GLDMC:
+  case GSTMC:
+    return "c";
+  case LDSI:
+  case LDMS:
+  case STMS:
+  case GLDSI:
+  case GLDMS:
+  case GSTMS:
+    return "s";
+  case LDMCI:
+  case STMCI:
+  case CONVINT:
+  case GLDMCI:
+  case GSTMCI:
+  case GCONVINT:
+    return "ci";
+  case LDMSI:
+  case STMSI:
+  case GLDMSI:
+  case GSTMSI:
+    return "si";
+  case CONVMODP:
+  case GCONVGF2N:
+    return "ic";
+  case MOVC:
+  case ADDCI:
+  case SUBCI:
+  case SUBCFI:
+  case MULCI:
+  case DIVCI:
+  case MODCI:
+  case LEGENDREC:
+  case DIGESTC:
+  case ANDCI:
+  case XORCI:
+  case ORCI:
+  case NOTC:
+  case SHLCI:
+  case SHRCI:
+  case GMOVC:
+  case GADDCI:
+  case GSUBCI:
+  case GSUBCFI:
+  case GMULCI:
+  case GDIVCI:
+  case GANDCI:
+  case GXORCI:
+  case GORCI:
+  case GNOTC:
+  case GSHLCI:
+  case GSHRCI:
+    return "cc";
+  case MOVS:
+  case ADDSI:
+  case SUBSI:
+  case SUBSFI:
+  case MULSI:
+  case GMOVS:
+  case GADDSI:
+  case GSUBSI:
+  case GSUBSFI:
+  case GMULSI:
+    return "ss";
+  case ADDC:
+  case SUBC:
+  case MULC:
+  case DIVC:
+  case MODC:
+  case ANDC:
+  case XORC:
+  case ORC:
+  case SHLC:
+  case SHRC:
+  case GADDC:
+  case GSUBC:
+  case GMULC:
+  case GDIVC:
+  case GMULBITC:
+  case GANDC:
+  case GXORC:
+  case GORC:
+    return "ccc";
+  case ADDS:
+  case SUBS:
+  case GADDS:
+  case GSUBS:
+    return "sss";
+  case ADDM:
+  case SUBML:
+  case MULM:
+  case GADDM:
+  case GSUBML:
+  case GMULM:
+  case GMULBITM:
+    return "ssc";
+  case SUBMR:
+  case GSUBMR:
+    return "scs";
+  case LDINT:
+  case ADDINT:
+  case SUBINT:
+  case MULINT:
+  case DIVINT:
+  case EQZC:
+  case LTZC:
+  case LTC:
+  case GTC:
+  case EQC:
+  case JMP:
+  case JMPNZ:
+  case JMPEQZ:
+  case JMPI:
+  case LDMINT:
+  case STMINT:
+  case LDMINTI:
+  case STMINTI:
+  case PUSHINT:
+  case POPINT:
+  case MOVINT:
+  case LDTN:
+  case LDARG:
+  case STARG:
+    return "";
+  default:
+    return 0;
+  }
+}
+
 inline
 unsigned Instruction::get_mem(RegType reg_type, SecrecyType sec_type) const
 {
@@ -548,6 +696,63 @@ ostream& operator<<(ostream& s,const Instruction& instr)
 } 
 
 
+// Element-wise operations on register vectors. Prime field elements
+// use the batch kernels unless the ranges partially overlap, in which
+// case the result depends on the order of operations.
+template<class T>
+inline bool batchable(const T* ans, const T* x, const T* y, int n)
+{
+  for (auto z : {x, y})
+    if (ans != z and ans < z + n and z < ans + n)
+      return false;
+  return true;
+}
+
+#define VECTOR_OP(NAME) \
+template<class T> \
+inline void NAME##_vector(T* ans, const T* x, const T* y, int n) \
+{ \
+  for (int i = 0; i < n; i++) \
+    ans[i].NAME(x[i], y[i]); \
+} \
+\
+template<int X> \
+inline void NAME##_vector(gfp_<X>* ans, const gfp_<X>* x, const gfp_<X>* y, \
+    int n) \
+{ \
+  if (batchable(ans, x, y, n)) \
+    gfp_<X>::NAME(ans, x, y, n); \
+  else \
+    for (int i = 0; i < n; i++) \
+      ans[i].NAME(x[i], y[i]); \
+}
+
+VECTOR_OP(add)
+VECTOR_OP(sub)
+VECTOR_OP(mul)
+#undef VECTOR_OP
+
+// sharings of prime field elements are vectors of field elements
+// with element-wise addition and subtraction
+#define SHARE_OP(NAME) \
+template<class T, class U> \
+inline void NAME##_shares(T* ans, const T* x, const T* y, int n, U*) \
+{ \
+  NAME##_vector(ans, x, y, n); \
+} \
+\
+template<class T, int X> \
+inline void NAME##_shares(T* ans, const T* x, const T* y, int n, gfp_<X>*) \
+{ \
+  static_assert(sizeof(T) % sizeof(gfp_<X>) == 0, "not a vector of gfp"); \
+  int m = n * (sizeof(T) / sizeof(gfp_<X>)); \
+  NAME##_vector((gfp_<X>*)ans, (const gfp_<X>*)x, (const gfp_<X>*)y, m); \
+}
+
+SHARE_OP(add)
+SHARE_OP(sub)
+#undef SHARE_OP
+
 template<class sint, class sgf2n>
 #ifndef __clang__
 __attribute__((always_inline))
@@ -590,24 +795,28 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
          Proc.get_S2_ref(r[0] + i).mul(Proc.read_S2(r[1] + i),Proc.read_C2(r[2] + i));
       return;
     case ADDC:
-      for (int i = 0; i < size; i++)
-        Proc.get_Cp_ref(r[0] + i).add(Proc.read_Cp(r[1] + i),Proc.read_Cp(r[2] + i));
+      add_vector(&Proc.get_Cp_ref(r[0]), &Proc.read_Cp(r[1]),
+          &Proc.read_Cp(r[2]), size);
+      return;
+    case SUBC:
+      sub_vector(&Proc.get_Cp_ref(r[0]), &Proc.read_Cp(r[1]),
+          &Proc.read_Cp(r[2]), size);
       return;
     case ADDS:
-      for (int i = 0; i < size; i++)
-        Proc.get_Sp_ref(r[0] + i).add(Proc.read_Sp(r[1] + i),Proc.read_Sp(r[2] + i));
+      add_shares(&Proc.get_Sp_ref(r[0]), &Proc.read_Sp(r[1]),
+          &Proc.read_Sp(r[2]), size, (typename sint::clear*) 0);
       return;
     case SUBS:
-      for (int i = 0; i < size; i++)
-        Proc.get_Sp_ref(r[0] + i).sub(Proc.read_Sp(r[1] + i),Proc.read_Sp(r[2] + i));
+      sub_shares(&Proc.get_Sp_ref(r[0]), &Proc.read_Sp(r[1]),
+          &Proc.read_Sp(r[2]), size, (typename sint::clear*) 0);
       return;
     case MULM:
       for (int i = 0; i < size; i++)
         Proc.get_Sp_ref(r[0] + i).mul(Proc.read_Sp(r[1] + i),Proc.read_Cp(r[2] + i));
       return;
     case MULC:
-      for (int i = 0; i < size; i++)
-        Proc.get_Cp_ref(r[0] + i).mul(Proc.read_Cp(r[1] + i),Proc.read_Cp(r[2] + i));
+      mul_vector(&Proc.get_Cp_ref(r[0]), &Proc.read_Cp(r[1]),
+          &Proc.read_Cp(r[2]), size);
       return;
     case TRIPLE:
       for (int i = 0; i < size; i++)
@@ -1139,6 +1348,12 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case GDOTPRODS:
         Proc.Proc2.protocol.dotprods(start, Proc.Proc2);
         return;
+      case MATMULS:
+        Proc.Procp.protocol.matmuls(start, Proc.Procp);
+        return;
+      case GMATMULS:
+        Proc.Proc2.protocol.matmuls(start, Proc.Proc2);
+        return;
       case JMP:
         Proc.PC += (signed int) n;
         break;
@@ -1446,6 +1661,70 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
   }
 }
 
+template<class T>
+inline void Instruction::flush_if_dependent(SubProcessor<T>& proc,
+    const char* operands) const
+{
+  for (int i = 0; operands[i]; i++)
+    if (proc.is_pending(operands[i], r[i], size))
+      {
+        proc.flush();
+        return;
+      }
+}
+
+template<class sint, class sgf2n>
+inline void Instruction::execute_lazily(Processor<sint, sgf2n>& Proc) const
+{
+  auto& Procp = Proc.Procp;
+  auto& Proc2 = Proc.Proc2;
+
+  switch (opcode)
+  {
+    case OPEN:
+      Procp.queue_open(start, size);
+      break;
+    case GOPEN:
+      Proc2.queue_open(start, size);
+      break;
+    case MULS:
+      Procp.queue_muls(start, size);
+      break;
+    case GMULS:
+      Proc2.queue_muls(start, size);
+      break;
+    case MULRS:
+      Procp.queue_mulrs(start);
+      break;
+    case GMULRS:
+      Proc2.queue_mulrs(start);
+      break;
+    case DOTPRODS:
+      Procp.queue_dotprods(start);
+      break;
+    case GDOTPRODS:
+      Proc2.queue_dotprods(start);
+      break;
+    default:
+      if (Procp.has_pending() or Proc2.has_pending())
+        {
+          auto operands = get_local_operands();
+          if (operands == 0)
+            {
+              Procp.flush();
+              Proc2.flush();
+            }
+          else if (is_gf2n_instruction())
+            flush_if_dependent(Proc2, operands);
+          else
+            flush_if_dependent(Procp, operands);
+        }
+      execute(Proc);
+      return;
+  }
+  Proc.PC++;
+}
+
 template<class sint, class sgf2n>
 void Program::execute(Processor<sint, sgf2n>& Proc) const
 {
@@ -1454,6 +1733,14 @@ void Program::execute(Processor<sint, sgf2n>& Proc) const
   octet seed[SEED_SIZE];
   memset(seed, 0, SEED_SIZE);
   Proc.shared_prng.SetSeed(seed);
-  while (Proc.PC<size)
-    { p[Proc.PC].execute(Proc); }
+  if (Proc.opts.lazy)
+    {
+      while (Proc.PC<size)
+        { p[Proc.PC].execute_lazily(Proc); }
+      Proc.Procp.flush();
+      Proc.Proc2.flush();
+    }
+  else
+    while (Proc.PC<size)
+      { p[Proc.PC].execute(Proc); }
 }
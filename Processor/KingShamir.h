@@ -0,0 +1,65 @@
+/*
+ * KingShamir.h
+ *
+ */
+
+#ifndef PROCESSOR_KINGSHAMIR_H_
+#define PROCESSOR_KINGSHAMIR_H_
+
+#include <vector>
+#include <array>
+using namespace std;
+
+#include "Replicated.h"
+#include "ShamirInput.h"
+
+template<class T> class ShamirShare;
+
+/*
+ * Multiplication following Damgard-Nielsen (Crypto 2007): the parties
+ * hold double sharings ([r]_t, [r]_2t) and send x*y + r in degree 2t
+ * to a king, who opens it and sends back the result. The king rotates
+ * between multiplications to spread the load, so every multiplication
+ * costs O(n) field elements instead of O(n^2) for resharing.
+ * Double sharings are extracted from random contributions of all
+ * parties using a Vandermonde matrix, producing n - t per round.
+ */
+template<class U>
+class KingShamir : public ProtocolBase<ShamirShare<U>>
+{
+    typedef ShamirShare<U> T;
+
+    int threshold;
+    int n_mul_players;
+    U rec_factor;
+
+    // for the Vandermonde table
+    ShamirInput<T> sharing;
+
+    SeededPRNG secure_prng;
+
+    vector<array<T, 2>> double_randomness;
+    vector<T> masks;
+
+    vector<octetStream> to_kings, from_kings;
+    int king;
+    vector<int> kings;
+    size_t next;
+
+    void buffer_double_random();
+    void share(const U& secret, int degree, const vector<vector<U>>& vandermonde,
+            vector<octetStream>& os, T& mine);
+
+public:
+    Player& P;
+
+    KingShamir(Player& P);
+
+    void init_mul(SubProcessor<T>* proc = 0);
+    U prepare_mul(const T& x, const T& y);
+    U prepare_product(const U& product);
+    void exchange();
+    T finalize_mul();
+};
+
+#endif /* PROCESSOR_KINGSHAMIR_H_ */
@@ -0,0 +1,169 @@
+/*
+ * KingShamir.cpp
+ *
+ */
+
+#include "KingShamir.h"
+#include "Shamir.h"
+#include "Machines/ShamirMachine.h"
+
+template<class U>
+KingShamir<U>::KingShamir(Player& P) :
+        sharing(0, P), king(0), next(0), P(P)
+{
+    threshold = ShamirMachine::s().threshold;
+    n_mul_players = 2 * threshold + 1;
+}
+
+template<class U>
+void KingShamir<U>::init_mul(SubProcessor<T>* proc)
+{
+    (void) proc;
+    int n = P.num_players();
+
+    if (rec_factor == 0 and P.my_num() < n_mul_players)
+        rec_factor = Shamir<U>::get_rec_factor(P.my_num(), n_mul_players);
+
+    to_kings.clear();
+    to_kings.resize(n);
+    from_kings.clear();
+    from_kings.resize(n);
+    masks.clear();
+    kings.clear();
+    next = 0;
+}
+
+template<class U>
+void KingShamir<U>::share(const U& secret, int degree,
+        const vector<vector<U>>& vandermonde, vector<octetStream>& os, T& mine)
+{
+    vector<U> coefficients(degree);
+    for (auto& x : coefficients)
+        x.randomize(secure_prng);
+
+    for (int i = 0; i < P.num_players(); i++)
+    {
+        U x = secret;
+        for (int j = 0; j < degree; j++)
+            x += coefficients[j] * vandermonde[i][j];
+        if (i == P.my_num())
+            mine = x;
+        else
+            x.pack(os[i]);
+    }
+}
+
+template<class U>
+void KingShamir<U>::buffer_double_random()
+{
+    int n = P.num_players();
+    int n_outputs = n - threshold;
+    int buffer_size = (1000 + n_outputs - 1) / n_outputs;
+
+    auto& vandermonde = sharing.get_vandermonde(
+            max(2 * threshold, n_outputs), n);
+
+    vector<octetStream> os(n), received(n);
+    // all sharings of degree t, then all of degree 2t
+    array<vector<vector<T>>, 2> dealt;
+    for (auto& x : dealt)
+        x.resize(n, vector<T>(buffer_size));
+    for (int k = 0; k < buffer_size; k++)
+    {
+        U secret = secure_prng.get<U>();
+        for (int l = 0; l < 2; l++)
+            share(secret, (l + 1) * threshold, vandermonde, os,
+                    dealt[l][P.my_num()][k]);
+    }
+
+    for (int offset = 1; offset < n; offset++)
+        P.pass_around(os[P.get_player(offset)],
+                received[P.get_player(-offset)], offset);
+
+    for (int i = 0; i < n; i++)
+        if (i != P.my_num())
+            for (int k = 0; k < buffer_size; k++)
+                for (int l = 0; l < 2; l++)
+                    dealt[l][i][k].unpack(received[i]);
+
+    array<vector<T>, 2> random;
+    for (int l = 0; l < 2; l++)
+        Shamir<U>::extract(random[l], dealt[l], vandermonde, n_outputs);
+    for (size_t i = 0; i < random[0].size(); i++)
+        double_randomness.push_back({{ random[0][i], random[1][i] }});
+}
+
+template<class U>
+U KingShamir<U>::prepare_mul(const T& x, const T& y)
+{
+    return prepare_product(x * y);
+}
+
+template<class U>
+U KingShamir<U>::prepare_product(const U& product)
+{
+    if (double_randomness.empty())
+        buffer_double_random();
+    auto& r = double_randomness.back();
+
+    if (P.my_num() < n_mul_players)
+        ((product + r[1]) * rec_factor).pack(to_kings[king]);
+
+    masks.push_back(r[0]);
+    double_randomness.pop_back();
+    kings.push_back(king);
+    king = (king + 1) % P.num_players();
+    return product;
+}
+
+template<class U>
+void KingShamir<U>::exchange()
+{
+    int n = P.num_players();
+    int my_num = P.my_num();
+    vector<octetStream> received(n);
+
+    // send degree-2t shares to the respective kings
+    for (int offset = 1; offset < n; offset++)
+    {
+        int receive_from = P.get_player(-offset);
+        int send_to = P.get_player(offset);
+        bool receive = receive_from < n_mul_players;
+        if (my_num < n_mul_players)
+        {
+            if (receive)
+                P.pass_around(to_kings[send_to], received[receive_from],
+                        offset);
+            else
+                P.send_to(send_to, to_kings[send_to], true);
+        }
+        else if (receive)
+            P.receive_player(receive_from, received[receive_from], true);
+    }
+    received[my_num] = to_kings[my_num];
+
+    // open and send back what I am king for
+    octetStream& opened = from_kings[my_num];
+    for (int k : kings)
+        if (k == my_num)
+        {
+            U sum = U(0);
+            for (int i = 0; i < n_mul_players; i++)
+            {
+                U share;
+                share.unpack(received[i]);
+                sum += share;
+            }
+            sum.pack(opened);
+        }
+
+    P.Broadcast_Receive(from_kings, true);
+}
+
+template<class U>
+ShamirShare<U> KingShamir<U>::finalize_mul()
+{
+    U opened;
+    opened.unpack(from_kings[kings[next]]);
+    return T(opened) - masks[next++];
+}
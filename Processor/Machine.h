@@ -77,7 +77,8 @@ class Machine : public BaseMachine
   Machine(int my_number, Names& playerNames, string progname,
       string memtype, int lg2, bool direct, int opening_sum, bool parallel,
       bool receive_threads, int max_broadcast, bool use_encryption, bool live_prep,
-      OnlineOptions opts);
+      OnlineOptions opts,
+      const typename sint::mac_key_type* external_mac_key = 0);
 
   const Names& get_N() { return N; }
 
@@ -23,7 +23,8 @@ template<class sint, class sgf2n>
 Machine<sint, sgf2n>::Machine(int my_number, Names& playerNames,
     string progname_str, string memtype, int lg2, bool direct,
     int opening_sum, bool parallel, bool receive_threads, int max_broadcast,
-    bool use_encryption, bool live_prep, OnlineOptions opts)
+    bool use_encryption, bool live_prep, OnlineOptions opts,
+    const typename sint::mac_key_type* external_mac_key)
   : my_number(my_number), N(playerNames), tn(0), numt(0), usage_unknown(false),
     direct(direct), opening_sum(opening_sum), parallel(parallel),
     receive_threads(receive_threads), max_broadcast(max_broadcast),
@@ -42,8 +43,19 @@ Machine<sint, sgf2n>::Machine(int my_number, Names& playerNames,
 
   try
     {
-      read_setup(prep_dir_prefix);
-      ::read_mac_keys(prep_dir_prefix, my_number, N.num_players(), alphapi, alpha2i);
+      if (external_mac_key)
+        {
+          // fields already set up by the caller, nothing from Player-Data
+          SeededPRNG G;
+          alphapi = *external_mac_key;
+          alpha2i.randomize(G);
+          mkdir_p(PREP_DIR);
+        }
+      else
+        {
+          read_setup(prep_dir_prefix);
+          ::read_mac_keys(prep_dir_prefix, my_number, N.num_players(), alphapi, alpha2i);
+        }
       read_mac_keys = true;
     }
   catch (file_error& e)
@@ -12,11 +12,22 @@
 
 #include <array>
 
+/*
+ * Checks tuples by sacrificing another tuple of the same type. Instead
+ * of opening every check value, the parties open random linear
+ * combinations of them with coefficients drawn after the masked values
+ * have been opened. These combinations are opened together with the
+ * masked values of the next batch, so one batch is always in flight
+ * and only released once it has been checked.
+ */
 template<class T>
 class MaliciousRepPrep : public BufferPrep<T>
 {
     typedef BufferPrep<T> super;
 
+    // number of random linear combinations per batch
+    static const int N_COMBINATIONS = 2;
+
     DataPositions honest_usage;
     ReplicatedPrep<typename T::Honest> honest_prep;
     typename T::Honest::Protocol* replicated;
@@ -29,8 +40,18 @@ class MaliciousRepPrep : public BufferPrep<T>
     vector<array<T, 3>> check_triples;
     vector<array<T, 2>> check_squares;
 
+    // batches waiting for their combined check
+    vector<array<T, 3>> unchecked_triples;
+    vector<array<T, 2>> unchecked_squares;
+    vector<T> unchecked_bits;
+    vector<T> triple_checks, square_checks, bit_checks;
+
     void clear_tmp();
 
+    void get_coins(PRNG& G, Player& P);
+    void combine(const vector<T>& checks, PRNG& G);
+    void verify(const vector<T>& checks, size_t offset, const char* type);
+
     void buffer_triples();
     void buffer_squares();
     void buffer_inverses();
@@ -38,48 +38,88 @@ void MaliciousRepPrep<U>::clear_tmp()
     check_squares.clear();
 }
 
+template<class T>
+void MaliciousRepPrep<T>::get_coins(PRNG& G, Player& P)
+{
+    octet seed[SEED_SIZE];
+    Create_Random_Seed(seed, P, SEED_SIZE);
+    G.SetSeed(seed);
+}
+
+template<class T>
+void MaliciousRepPrep<T>::combine(const vector<T>& checks, PRNG& G)
+{
+    if (checks.empty())
+        return;
+    for (int i = 0; i < N_COMBINATIONS; i++)
+    {
+        T sum;
+        for (auto& check : checks)
+            sum += check * G.get<typename T::clear>();
+        masked.push_back(sum);
+    }
+}
+
+template<class T>
+void MaliciousRepPrep<T>::verify(const vector<T>& checks, size_t offset,
+        const char* type)
+{
+    if (checks.empty())
+        return;
+    for (int i = 0; i < N_COMBINATIONS; i++)
+        if (opened.at(offset + i) != 0)
+            throw Offline_Check_Error(type);
+}
+
 template<class T>
 void MaliciousRepPrep<T>::buffer_triples()
 {
     auto& triples = this->triples;
     auto buffer_size = this->buffer_size;
-    clear_tmp();
     Player& P = honest_prep.protocol->P;
     triples.clear();
-    for (int i = 0; i < buffer_size; i++)
-    {
-        T a, b, c;
-        T f, g, h;
-        honest_prep.get_three_no_count(DATA_TRIPLE, a, b, c);
-        honest_prep.get_three_no_count(DATA_TRIPLE, f, g, h);
-        triples.push_back({{a, b, c}});
-        check_triples.push_back({{f, g, h}});
-    }
-    auto t = Create_Random<typename T::clear>(P);
-    for (int i = 0; i < buffer_size; i++)
+    while (triples.empty())
     {
-        T& a = triples[i][0];
-        T& b = triples[i][1];
-        T& f = check_triples[i][0];
-        T& g = check_triples[i][1];
-        masked.push_back(a * t - f);
-        masked.push_back(b - g);
+        clear_tmp();
+        vector<array<T, 3>> new_triples;
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T a, b, c;
+            T f, g, h;
+            honest_prep.get_three_no_count(DATA_TRIPLE, a, b, c);
+            honest_prep.get_three_no_count(DATA_TRIPLE, f, g, h);
+            new_triples.push_back({{a, b, c}});
+            check_triples.push_back({{f, g, h}});
+        }
+        PRNG G;
+        get_coins(G, P);
+        auto t = G.get<typename T::clear>();
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T& a = new_triples[i][0];
+            T& b = new_triples[i][1];
+            T& f = check_triples[i][0];
+            T& g = check_triples[i][1];
+            masked.push_back(a * t - f);
+            masked.push_back(b - g);
+        }
+        combine(triple_checks, G);
+        MC.POpen(opened, masked, P);
+        verify(triple_checks, 2 * buffer_size, "triple");
+        triples.swap(unchecked_triples);
+        unchecked_triples.swap(new_triples);
+        triple_checks.clear();
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T& b = unchecked_triples[i][1];
+            T& c = unchecked_triples[i][2];
+            T& f = check_triples[i][0];
+            T& h = check_triples[i][2];
+            typename T::clear& rho = opened[2 * i];
+            typename T::clear& sigma = opened[2 * i + 1];
+            triple_checks.push_back(t * c - h - rho * b - sigma * f);
+        }
     }
-    MC.POpen(opened, masked, P);
-    for (int i = 0; i < buffer_size; i++)
-    {
-        T& b = triples[i][1];
-        T& c = triples[i][2];
-        T& f = check_triples[i][0];
-        T& h = check_triples[i][2];
-        typename T::clear& rho = opened[2 * i];
-        typename T::clear& sigma = opened[2 * i + 1];
-        checks.push_back(t * c - h - rho * b - sigma * f);
-    }
-    MC.POpen(opened, checks, P);
-    for (auto& check : opened)
-        if (check != 0)
-            throw Offline_Check_Error("triple");
     MC.Check(P);
 }
 
@@ -88,39 +128,46 @@ void MaliciousRepPrep<T>::buffer_squares()
 {
     auto& squares = this->squares;
     auto buffer_size = this->buffer_size;
-    clear_tmp();
     Player& P = honest_prep.protocol->P;
     squares.clear();
-    for (int i = 0; i < buffer_size; i++)
-    {
-        T a, b;
-        T f, h;
-        honest_prep.get_two(DATA_SQUARE, a, b);
-        honest_prep.get_two(DATA_SQUARE, f, h);
-        squares.push_back({{a, b}});
-        check_squares.push_back({{f, h}});
-    }
-    auto t = Create_Random<typename T::clear>(P);
-    for (int i = 0; i < buffer_size; i++)
+    while (squares.empty())
     {
-        T& a = squares[i][0];
-        T& f = check_squares[i][0];
-        masked.push_back(a * t - f);
+        clear_tmp();
+        vector<array<T, 2>> new_squares;
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T a, b;
+            T f, h;
+            honest_prep.get_two(DATA_SQUARE, a, b);
+            honest_prep.get_two(DATA_SQUARE, f, h);
+            new_squares.push_back({{a, b}});
+            check_squares.push_back({{f, h}});
+        }
+        PRNG G;
+        get_coins(G, P);
+        auto t = G.get<typename T::clear>();
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T& a = new_squares[i][0];
+            T& f = check_squares[i][0];
+            masked.push_back(a * t - f);
+        }
+        combine(square_checks, G);
+        MC.POpen(opened, masked, P);
+        verify(square_checks, buffer_size, "square");
+        squares.swap(unchecked_squares);
+        unchecked_squares.swap(new_squares);
+        square_checks.clear();
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T& a = unchecked_squares[i][0];
+            T& b = unchecked_squares[i][1];
+            T& f = check_squares[i][0];
+            T& h = check_squares[i][1];
+            auto& rho = opened[i];
+            square_checks.push_back(t * t * b - h - rho * (t * a + f));
+        }
     }
-    MC.POpen(opened, masked, P);
-    for (int i = 0; i < buffer_size; i++)
-    {
-        T& a = squares[i][0];
-        T& b = squares[i][1];
-        T& f = check_squares[i][0];
-        T& h = check_squares[i][1];
-        auto& rho = opened[i];
-        checks.push_back(t * t * b - h - rho * (t * a + f));
-    }
-    MC.POpen(opened, checks, P);
-    for (auto& check : opened)
-        if (check != 0)
-            throw Offline_Check_Error("square");
 }
 
 template<class T>
@@ -134,35 +181,42 @@ void MaliciousRepPrep<T>::buffer_bits()
 {
     auto& bits = this->bits;
     auto buffer_size = this->buffer_size;
-    clear_tmp();
     Player& P = honest_prep.protocol->P;
     bits.clear();
-    for (int i = 0; i < buffer_size; i++)
-    {
-        T a, f, h;
-        honest_prep.get_one(DATA_BIT, a);
-        honest_prep.get_two(DATA_SQUARE, f, h);
-        bits.push_back(a);
-        check_squares.push_back({{f, h}});
-    }
-    auto t = Create_Random<typename T::clear>(P);
-    for (int i = 0; i < buffer_size; i++)
-    {
-        T& a = bits[i];
-        T& f = check_squares[i][0];
-        masked.push_back(t * a - f);
-    }
-    MC.POpen(opened, masked, P);
-    for (int i = 0; i < buffer_size; i++)
+    while (bits.empty())
     {
-        T& a = bits[i];
-        T& f = check_squares[i][0];
-        T& h = check_squares[i][1];
-        auto& rho = opened[i];
-        masked.push_back(t * t * a - h - rho * (t * a + f));
+        clear_tmp();
+        vector<T> new_bits;
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T a, f, h;
+            honest_prep.get_one(DATA_BIT, a);
+            honest_prep.get_two(DATA_SQUARE, f, h);
+            new_bits.push_back(a);
+            check_squares.push_back({{f, h}});
+        }
+        PRNG G;
+        get_coins(G, P);
+        auto t = G.get<typename T::clear>();
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T& a = new_bits[i];
+            T& f = check_squares[i][0];
+            masked.push_back(t * a - f);
+        }
+        combine(bit_checks, G);
+        MC.POpen(opened, masked, P);
+        verify(bit_checks, buffer_size, "bit");
+        bits.swap(unchecked_bits);
+        unchecked_bits.swap(new_bits);
+        bit_checks.clear();
+        for (int i = 0; i < buffer_size; i++)
+        {
+            T& a = unchecked_bits[i];
+            T& f = check_squares[i][0];
+            T& h = check_squares[i][1];
+            auto& rho = opened[i];
+            bit_checks.push_back(t * t * a - h - rho * (t * a + f));
+        }
     }
-    MC.POpen(opened, checks, P);
-    for (auto& check : opened)
-        if (check != 0)
-            throw Offline_Check_Error("bit");
 }
@@ -32,6 +32,7 @@ void OTPrep<T>::set_protocol(typename T::Protocol& protocol)
     assert(not ot_setups.empty());
     OTTripleSetup setup = ot_setups.back();
     ot_setups.pop_back();
+    params.silent_ot = proc->Proc.opts.silent_ot;
     params.set_mac_key(typename T::mac_key_type::next(proc->MC.get_alphai()));
     triple_generator = new typename T::TripleGenerator(setup,
             proc->P.N, proc->Proc.thread_num, this->buffer_size, 1,
@@ -153,7 +153,8 @@ void* Sub_Main_Func(void* ptr)
           MC2->Check(P);
           MCp->Check(P);
           //printf("\tMAC checked\n");
-          P.Check_Broadcast();
+          if (not machine.opts.defer_broadcast_check)
+            P.Check_Broadcast();
           //printf("\tBroadcast checked\n");
 
          // printf("\tSignalling I have finished\n");
@@ -12,6 +12,10 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     interactive = false;
     lgp = 128;
     live_prep = true;
+    async_prep = false;
+    defer_broadcast_check = false;
+    lazy = false;
+    silent_ot = false;
 }
 
 OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
@@ -46,6 +50,42 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-F", // Flag token.
             "--file-preprocessing" // Flag token.
     );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Preprocessing in background threads (default: disabled)", // Help description.
+            "-A", // Flag token.
+            "--async-preprocessing" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Check consistency of broadcasts only at the end instead of after every program (default: disabled)", // Help description.
+            "-D", // Flag token.
+            "--defer-broadcast-check" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Merge independent openings and multiplications across instructions into one round (default: disabled)", // Help description.
+            "-L", // Flag token.
+            "--lazy" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Correlated OT by LPN expansion instead of OT extension in OT-based preprocessing (default: disabled)", // Help description.
+            "-V", // Flag token.
+            "--silent-ot" // Flag token.
+    );
     opt.add(
             "", // Default.
             0, // Required?
@@ -61,6 +101,10 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
     interactive = opt.isSet("-I");
     opt.get("--lgp")->getInt(lgp);
     live_prep = not opt.get("-F")->isSet;
+    async_prep = opt.isSet("-A");
+    defer_broadcast_check = opt.isSet("-D");
+    lazy = opt.isSet("-L");
+    silent_ot = opt.isSet("-V");
 
     opt.resetArgs();
 }
@@ -14,6 +14,10 @@ public:
     bool interactive;
     int lgp;
     bool live_prep;
+    bool async_prep;
+    bool defer_broadcast_check;
+    bool lazy;
+    bool silent_ot;
     int playerno;
     std::string progname;
 
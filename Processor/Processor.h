@@ -38,7 +38,21 @@ class SubProcessor
   vector<typename T::open_type> PO;
   vector<T> Sh_PO;
 
-  void resize(int size)       { C.resize(size); S.resize(size); }
+  // tag of plain products in product_dest, distinct from any dot
+  // product length including zero
+  static const int PRODUCT = -1;
+
+  // Registers still to be written by queued openings and multiplications
+  // in lazy execution, with the length of dot products (PRODUCT for products)
+  vector<bool> pending_C, pending_S;
+  vector<int> open_dest;
+  vector<T> open_shares;
+  vector<pair<int, int>> product_dest;
+
+  void resize(int size);
+
+  bool is_pending(const vector<bool>& pending, int reg, int size);
+  void start_products();
 
   template<class sint, class sgf2n> friend class Processor;
   template<class U> friend class SPDZ;
@@ -65,6 +79,17 @@ public:
   void muls(const vector<int>& reg, int size);
   void mulrs(const vector<int>& reg);
   void dotprods(const vector<int>& reg);
+  void matmuls(const vector<int>& reg);
+
+  // Lazy execution: queue openings and multiplications, reading the
+  // inputs immediately, and only communicate when flushing
+  bool has_pending() { return not (open_dest.empty() and product_dest.empty()); }
+  bool is_pending(char kind, int reg, int size);
+  void queue_open(const vector<int>& reg, int size);
+  void queue_muls(const vector<int>& reg, int size);
+  void queue_mulrs(const vector<int>& reg);
+  void queue_dotprods(const vector<int>& reg);
+  void flush();
 
   vector<T>& get_S()
   {
@@ -19,6 +19,15 @@ SubProcessor<T>::SubProcessor(ArithmeticProcessor& Proc, typename T::MAC_Check&
   DataF.set_protocol(protocol);
 }
 
+template <class T>
+void SubProcessor<T>::resize(int size)
+{
+  C.resize(size);
+  S.resize(size);
+  pending_C.resize(size);
+  pending_S.resize(size);
+}
+
 template<class sint, class sgf2n>
 Processor<sint, sgf2n>::Processor(int thread_num,Player& P,
         typename sgf2n::MAC_Check& MC2,typename sint::MAC_Check& MCp,
@@ -560,6 +569,178 @@ void SubProcessor<T>::dotprods(const vector<int>& reg)
    }
 }
 
+template<class T>
+void SubProcessor<T>::matmuls(const vector<int>& reg)
+{
+    assert(reg.size() == 6);
+    int m = reg[3], n = reg[4], k = reg[5];
+    auto A = S.begin() + reg[1];
+    auto B = S.begin() + reg[2];
+
+    protocol.init_dotprod(this);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < k; j++)
+        {
+            for (int l = 0; l < n; l++)
+                protocol.prepare_dotprod(A[i * n + l], B[l * k + j]);
+            protocol.next_dotprod();
+        }
+    protocol.exchange();
+    for (int i = 0; i < m * k; i++)
+        S[reg[0] + i] = protocol.finalize_dotprod(n);
+}
+
+template<class T>
+inline bool SubProcessor<T>::is_pending(const vector<bool>& pending, int reg,
+    int size)
+{
+  for (int i = max(reg, 0); i < min(reg + size, int(pending.size())); i++)
+    if (pending[i])
+      return true;
+  return false;
+}
+
+template<class T>
+bool SubProcessor<T>::is_pending(char kind, int reg, int size)
+{
+  switch (kind)
+  {
+  case 's':
+    return is_pending(pending_S, reg, size);
+  case 'c':
+    return is_pending(pending_C, reg, size);
+  default:
+    return false;
+  }
+}
+
+template<class T>
+void SubProcessor<T>::queue_open(const vector<int>& reg, int size)
+{
+  assert(reg.size() % 2 == 0);
+  for (size_t i = 1; i < reg.size(); i += 2)
+    if (is_pending(pending_S, reg[i], size))
+      {
+        flush();
+        break;
+      }
+
+  for (size_t i = 0; i < reg.size(); i += 2)
+    for (int j = 0; j < size; j++)
+      {
+        open_shares.push_back(S[reg[i + 1] + j]);
+        open_dest.push_back(reg[i] + j);
+        pending_C[reg[i] + j] = true;
+      }
+}
+
+template<class T>
+void SubProcessor<T>::start_products()
+{
+  if (product_dest.empty())
+    protocol.init_dotprod(this);
+}
+
+template<class T>
+void SubProcessor<T>::queue_muls(const vector<int>& reg, int size)
+{
+  assert(reg.size() % 3 == 0);
+  for (size_t i = 0; i < reg.size(); i += 3)
+    if (is_pending(pending_S, reg[i + 1], size)
+        or is_pending(pending_S, reg[i + 2], size))
+      {
+        flush();
+        break;
+      }
+
+  start_products();
+  for (size_t i = 0; i < reg.size(); i += 3)
+    for (int j = 0; j < size; j++)
+      {
+        protocol.prepare_mul(S[reg[i + 1] + j], S[reg[i + 2] + j]);
+        product_dest.push_back({reg[i] + j, PRODUCT});
+        pending_S[reg[i] + j] = true;
+      }
+}
+
+template<class T>
+void SubProcessor<T>::queue_mulrs(const vector<int>& reg)
+{
+  assert(reg.size() % 4 == 0);
+  for (size_t i = 0; i < reg.size(); i += 4)
+    if (is_pending(pending_S, reg[i + 2], reg[i])
+        or is_pending(pending_S, reg[i + 3], 1))
+      {
+        flush();
+        break;
+      }
+
+  start_products();
+  for (size_t i = 0; i < reg.size(); i += 4)
+    for (int j = 0; j < reg[i]; j++)
+      {
+        protocol.prepare_mul(S[reg[i + 2] + j], S[reg[i + 3]]);
+        product_dest.push_back({reg[i + 1] + j, PRODUCT});
+        pending_S[reg[i + 1] + j] = true;
+      }
+}
+
+template<class T>
+void SubProcessor<T>::queue_dotprods(const vector<int>& reg)
+{
+  bool dependent = false;
+  for (auto it = reg.begin(); it != reg.end(); it += *it)
+    for (auto x = it + 2; x != it + *it; x++)
+      dependent |= pending_S[*x];
+  if (dependent)
+    flush();
+
+  start_products();
+  for (auto it = reg.begin(); it != reg.end(); it += *it)
+    {
+      for (auto x = it + 2; x != it + *it; x += 2)
+        protocol.prepare_dotprod(S[*x], S[*(x + 1)]);
+      protocol.next_dotprod();
+      product_dest.push_back({*(it + 1), (*it - 2) / 2});
+      pending_S[*(it + 1)] = true;
+    }
+}
+
+template<class T>
+void SubProcessor<T>::flush()
+{
+  if (not open_dest.empty())
+    {
+      MC.POpen(PO, open_shares, P);
+      for (size_t i = 0; i < open_dest.size(); i++)
+        {
+          C[open_dest[i]] = PO[i];
+          pending_C[open_dest[i]] = false;
+        }
+      Proc.sent += open_dest.size();
+      Proc.rounds++;
+      open_dest.clear();
+      open_shares.clear();
+    }
+
+  if (not product_dest.empty())
+    {
+      protocol.exchange();
+      for (auto& dest : product_dest)
+        {
+          if (dest.second == PRODUCT)
+            {
+              S[dest.first] = protocol.finalize_mul();
+              protocol.counter++;
+            }
+          else
+            S[dest.first] = protocol.finalize_dotprod(dest.second);
+          pending_S[dest.first] = false;
+        }
+      product_dest.clear();
+    }
+}
+
 template<class sint, class sgf2n>
 ostream& operator<<(ostream& s,const Processor<sint, sgf2n>& P)
 {
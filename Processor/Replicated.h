@@ -49,6 +49,7 @@ public:
             int size);
     void mulrs(const vector<int>& reg, SubProcessor<T>& proc);
     void dotprods(const vector<int>& reg, SubProcessor<T>& proc);
+    void matmuls(const vector<int>& reg, SubProcessor<T>& proc);
 
     virtual void init_mul(SubProcessor<T>* proc) = 0;
     virtual typename T::clear prepare_mul(const T& x, const T& y) = 0;
@@ -96,6 +97,8 @@ public:
     void next_dotprod();
     T finalize_dotprod(int length);
 
+    void matmuls(const vector<int>& reg, SubProcessor<T>& proc);
+
     T get_random();
 };
 
@@ -6,6 +6,7 @@
 #include "Replicated.h"
 #include "Processor.h"
 #include "Tools/benchmarking.h"
+#include "Math/MatrixMul.h"
 
 template<class T>
 ProtocolBase<T>::ProtocolBase() : counter(0)
@@ -63,6 +64,13 @@ void ProtocolBase<T>::dotprods(const vector<int>& reg,
     proc.dotprods(reg);
 }
 
+template<class T>
+void ProtocolBase<T>::matmuls(const vector<int>& reg,
+        SubProcessor<T>& proc)
+{
+    proc.matmuls(reg);
+}
+
 template<class T>
 T ProtocolBase<T>::finalize_dotprod(int length)
 {
@@ -154,6 +162,41 @@ inline T Replicated<T>::finalize_dotprod(int length)
     return finalize_mul();
 }
 
+template<class T>
+void Replicated<T>::matmuls(const vector<int>& reg, SubProcessor<T>& proc)
+{
+    assert(reg.size() == 6);
+    int m = reg[3], n = reg[4], k = reg[5];
+    typedef typename T::clear U;
+    auto& S = proc.get_S();
+
+    // cross-terms as in local_mul(): A[0] * (B[0] + B[1]) + A[1] * B[0]
+    vector<U> a0(m * n), a1(m * n), b0(n * k), b_sum(n * k), c(m * k);
+    for (int i = 0; i < m * n; i++)
+    {
+        auto& x = S[reg[1] + i];
+        a0[i] = x[0];
+        a1[i] = x[1];
+    }
+    for (int i = 0; i < n * k; i++)
+    {
+        auto& x = S[reg[2] + i];
+        b0[i] = x[0];
+        b_sum[i] = x.sum();
+    }
+    matrix_mul_add(c.data(), a0.data(), b_sum.data(), m, n, k);
+    matrix_mul_add(c.data(), a1.data(), b0.data(), m, n, k);
+
+    init_mul();
+    for (auto& x : c)
+        prepare_reshare(x);
+    exchange();
+    for (int i = 0; i < m * k; i++)
+        S[reg[0] + i] = finalize_mul();
+
+    this->counter += m * n * k;
+}
+
 template<class T>
 T Replicated<T>::get_random()
 {
@@ -14,6 +14,8 @@
 template<class T>
 class BufferPrep : public Preprocessing<T>
 {
+    template<class U> friend class AsyncPrep;
+
 protected:
     vector<array<T, 3>> triples;
     vector<array<T, 2>> squares;
@@ -41,6 +43,7 @@ public:
     void get_input_no_count(T& a, typename T::open_type& x, int i);
     void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs,
             int vector_size);
+    void get_triples_no_count(vector<array<T, 3>>& triples, int n);
 };
 
 template<class T>
@@ -60,6 +60,24 @@ void BufferPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
     triples.pop_back();
 }
 
+template<class T>
+void BufferPrep<T>::get_triples_no_count(vector<array<T, 3>>& res, int n)
+{
+    res.resize(n);
+    int done = 0;
+    while (done < n)
+    {
+        if (triples.empty())
+            buffer_triples();
+
+        // same order as repeated get_three_no_count()
+        int m = min(n - done, int(triples.size()));
+        copy(triples.rbegin(), triples.rbegin() + m, res.begin() + done);
+        triples.resize(triples.size() - m);
+        done += m;
+    }
+}
+
 template<class T>
 void RingPrep<T>::buffer_squares()
 {
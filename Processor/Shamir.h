@@ -15,6 +15,7 @@ template<class T> class SubProcessor;
 template<class T> class ShamirMC;
 template<class T> class ShamirShare;
 template<class T> class ShamirInput;
+template<class T> class KingShamir;
 
 class Player;
 
@@ -27,6 +28,7 @@ class Shamir : public ProtocolBase<ShamirShare<U>>
     vector<U> reconstruction;
     U rec_factor;
     ShamirInput<T>* resharing;
+    KingShamir<U>* king;
 
     SeededPRNG secure_prng;
 
@@ -42,6 +44,9 @@ public:
 
     static U get_rec_factor(int i, int n);
 
+    static void extract(vector<T>& random, const vector<vector<T>>& dealt,
+            const vector<vector<U>>& vandermonde, int n_outputs);
+
     Shamir(Player& P);
     ~Shamir();
 
@@ -52,9 +57,12 @@ public:
     void init_mul();
     void init_mul(SubProcessor<T>* proc);
     U prepare_mul(const T& x, const T& y);
+    U prepare_product(const U& product);
     void exchange();
     T finalize_mul();
 
+    void matmuls(const vector<int>& reg, SubProcessor<T>& proc);
+
     T finalize(int n_input_players);
 
     T get_random();
@@ -5,7 +5,9 @@
 
 #include "Shamir.h"
 #include "ShamirInput.h"
+#include "KingShamir.hpp"
 #include "Machines/ShamirMachine.h"
+#include "Math/MatrixMul.h"
 
 template<class U>
 U Shamir<U>::get_rec_factor(int i, int n)
@@ -18,7 +20,7 @@ U Shamir<U>::get_rec_factor(int i, int n)
 }
 
 template<class U>
-Shamir<U>::Shamir(Player& P) : resharing(0), P(P)
+Shamir<U>::Shamir(Player& P) : resharing(0), king(0), P(P)
 {
     if (not P.is_encrypted())
         insecure("unencrypted communication");
@@ -31,6 +33,8 @@ Shamir<U>::~Shamir()
 {
     if (resharing != 0)
         delete resharing;
+    if (king != 0)
+        delete king;
 }
 
 template<class U>
@@ -64,6 +68,14 @@ void Shamir<U>::init_mul(SubProcessor<T>* proc)
 template<class U>
 void Shamir<U>::init_mul()
 {
+    if (ShamirMachine::s().king)
+    {
+        if (king == 0)
+            king = new KingShamir<U>(P);
+        king->init_mul();
+        return;
+    }
+
     reset();
     if (rec_factor == 0 and P.my_num() < n_mul_players)
         rec_factor = get_rec_factor(P.my_num(), n_mul_players);
@@ -72,7 +84,15 @@ void Shamir<U>::init_mul()
 template<class U>
 U Shamir<U>::prepare_mul(const T& x, const T& y)
 {
-    auto add_share = x * y * rec_factor;
+    return prepare_product(x * y);
+}
+
+template<class U>
+U Shamir<U>::prepare_product(const U& product)
+{
+    if (king)
+        return king->prepare_product(product);
+    auto add_share = product * rec_factor;
     if (P.my_num() < n_mul_players)
         resharing->add_mine(add_share);
     return add_share;
@@ -81,6 +101,11 @@ U Shamir<U>::prepare_mul(const T& x, const T& y)
 template<class U>
 void Shamir<U>::exchange()
 {
+    if (king)
+    {
+        king->exchange();
+        return;
+    }
     for (int offset = 1; offset < P.num_players(); offset++)
     {
         int receive_from = P.get_player(-offset);
@@ -101,9 +126,34 @@ void Shamir<U>::exchange()
 template<class U>
 ShamirShare<U> Shamir<U>::finalize_mul()
 {
+    if (king)
+        return king->finalize_mul();
     return finalize(n_mul_players);
 }
 
+template<class U>
+void Shamir<U>::matmuls(const vector<int>& reg, SubProcessor<T>& proc)
+{
+    static_assert(sizeof(T) == sizeof(U), "shares are not field elements");
+    assert(reg.size() == 6);
+    int m = reg[3], n = reg[4], k = reg[5];
+
+    // local products have degree 2t like the product of two shares
+    auto& S = proc.get_S();
+    vector<U> products(m * k);
+    matrix_mul_add(products.data(), (const U*) &S[reg[1]],
+            (const U*) &S[reg[2]], m, n, k);
+
+    init_mul();
+    for (auto& product : products)
+        prepare_product(product);
+    exchange();
+    for (int i = 0; i < m * k; i++)
+        S[reg[0] + i] = finalize_mul();
+
+    this->counter += m * n * k;
+}
+
 template<class U>
 ShamirShare<U> Shamir<U>::finalize(int n_relevant_players)
 {
@@ -120,6 +170,24 @@ ShamirShare<U> Shamir<U>::finalize(int n_relevant_players)
     return res;
 }
 
+template<class U>
+void Shamir<U>::extract(vector<T>& random, const vector<vector<T>>& dealt,
+        const vector<vector<U>>& vandermonde, int n_outputs)
+{
+    static_assert(sizeof(T) == sizeof(U), "shares are not field elements");
+    size_t n_dealt = dealt.at(0).size();
+    vector<U> sum(n_dealt);
+    for (int j = 0; j < n_outputs; j++)
+    {
+        for (auto& x : sum)
+            x.assign_zero();
+        for (size_t i = 0; i < dealt.size(); i++)
+            mul_add(sum.data(), vandermonde[i][j], (const U*) dealt[i].data(),
+                    n_dealt);
+        random.insert(random.end(), sum.begin(), sum.end());
+    }
+}
+
 template<class U>
 ShamirShare<U> Shamir<U>::get_random()
 {
@@ -133,13 +201,26 @@ ShamirShare<U> Shamir<U>::get_random()
 template<class U>
 void Shamir<U>::buffer_random()
 {
+    // every party deals, and a Vandermonde matrix turns n sharings
+    // into n - t random ones even if t of them are known to the adversary
+    int n = P.num_players();
+    int n_outputs = n - threshold;
+    int buffer_size = (1000 + n_outputs - 1) / n_outputs;
     Shamir<U> shamir(P);
     shamir.reset();
-    int buffer_size = 1000;
-    if (P.my_num() <= threshold)
-        for (int i = 0; i < buffer_size; i++)
-            shamir.resharing->add_mine(secure_prng.get<U>());
-    shamir.exchange();
+    shamir.n_mul_players = n;
     for (int i = 0; i < buffer_size; i++)
-        random.push_back(shamir.finalize(threshold + 1));
+        shamir.resharing->add_mine(secure_prng.get<U>());
+    shamir.exchange();
+
+    vector<vector<T>> dealt(n, vector<T>(buffer_size));
+    for (int i = 0; i < n; i++)
+        for (auto& x : dealt[i])
+            if (i == P.my_num())
+                x = shamir.resharing->finalize_mine();
+            else
+                shamir.resharing->finalize_other(i, x, shamir.os[i]);
+
+    extract(random, dealt, shamir.resharing->get_vandermonde(n_outputs, n),
+            n_outputs);
 }
@@ -55,6 +55,9 @@ public:
     {
     }
 
+    // powers (i + 1)^(j + 1) for party i and j < t
+    const vector<vector<typename T::clear>>& get_vandermonde(size_t t, int n);
+
     void add_mine(const typename T::clear& input);
 };
 
@@ -19,24 +19,33 @@ void IndividualInput<U>::reset(int player)
 }
 
 template<class T>
-void ShamirInput<T>::add_mine(const typename T::clear& input)
+const vector<vector<typename T::clear>>& ShamirInput<T>::get_vandermonde(
+        size_t t, int n)
 {
-    auto& P = this->P;
-    int n = P.num_players();
-    int t = ShamirMachine::s().threshold;
-    if (vandermonde.empty())
+    if (vandermonde.empty() or vandermonde[0].size() < t)
     {
         vandermonde.resize(n, vector<typename T::clear>(t));
         for (int i = 0; i < n; i++)
         {
+            vandermonde[i].resize(t);
             typename T::clear x = 1;
-            for (int j = 0; j < t; j++)
+            for (size_t j = 0; j < t; j++)
             {
                 x *= (i + 1);
                 vandermonde[i][j] = x;
             }
         }
     }
+    return vandermonde;
+}
+
+template<class T>
+void ShamirInput<T>::add_mine(const typename T::clear& input)
+{
+    auto& P = this->P;
+    int n = P.num_players();
+    int t = ShamirMachine::s().threshold;
+    auto& vandermonde = get_vandermonde(t, n);
 
     randomness.resize(t);
     for (auto& x : randomness)
@@ -0,0 +1,62 @@
+/*
+ * StreamPrep.h
+ *
+ */
+
+#ifndef PROCESSOR_STREAMPREP_H_
+#define PROCESSOR_STREAMPREP_H_
+
+#include "ReplicatedPrep.h"
+#include "Tools/SpscRing.h"
+
+/*
+ * Takes tuples from producers running in the same process instead of
+ * reading them from files. There is one ring per online thread and
+ * data type, which have to be registered before the online threads
+ * start. Everything without a ring comes from the preprocessing that
+ * would be used otherwise.
+ */
+template<class T>
+class StreamPrep : public BufferPrep<T>
+{
+    static vector<array<TupleStream<T>*, N_DTYPE>> streams;
+
+    Preprocessing<T>& fallback;
+    array<TupleStream<T>*, N_DTYPE> mine;
+
+    void fetch(vector<array<T, 3>>& batch, Dtype dtype);
+
+    void buffer_triples();
+    void buffer_squares();
+    void buffer_inverses();
+    void buffer_bits();
+
+public:
+    static TupleStream<T>& get_stream(int thread_num, Dtype dtype);
+    static bool active() { return not streams.empty(); }
+    // consumers are done, to be called when all online threads have finished
+    static void close_streams();
+    static void delete_streams();
+
+    StreamPrep(DataPositions& usage, Preprocessing<T>& fallback);
+    ~StreamPrep();
+
+    void set_protocol(typename T::Protocol& protocol);
+    void set_proc(SubProcessor<T>* proc);
+
+    void seekg(DataPositions& pos);
+    void prune() { fallback.prune(); }
+    void purge() { fallback.purge(); }
+
+    size_t data_sent() { return fallback.data_sent(); }
+
+    void get_three_no_count(Dtype dtype, T& a, T& b, T& c);
+    void get_two_no_count(Dtype dtype, T& a, T& b);
+    void get_one_no_count(Dtype dtype, T& a);
+    void get_input_no_count(T& a, typename T::open_type& x, int i);
+    void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs,
+            int vector_size);
+    void get_triples_no_count(vector<array<T, 3>>& triples, int n);
+};
+
+#endif /* PROCESSOR_STREAMPREP_H_ */
@@ -0,0 +1,167 @@
+/*
+ * StreamPrep.hpp
+ *
+ */
+
+#include "StreamPrep.h"
+#include "Processor/Processor.h"
+
+template<class T>
+vector<array<TupleStream<T>*, N_DTYPE>> StreamPrep<T>::streams;
+
+template<class T>
+TupleStream<T>& StreamPrep<T>::get_stream(int thread_num, Dtype dtype)
+{
+    if (streams.size() <= size_t(thread_num))
+        streams.resize(thread_num + 1, {});
+    auto& stream = streams[thread_num][dtype];
+    if (stream == 0)
+        stream = new TupleStream<T>;
+    return *stream;
+}
+
+template<class T>
+void StreamPrep<T>::close_streams()
+{
+    for (auto& x : streams)
+        for (auto stream : x)
+            if (stream)
+                stream->close();
+}
+
+template<class T>
+void StreamPrep<T>::delete_streams()
+{
+    for (auto& x : streams)
+        for (auto stream : x)
+            delete stream;
+    streams.clear();
+}
+
+template<class T>
+StreamPrep<T>::StreamPrep(DataPositions& usage, Preprocessing<T>& fallback) :
+        BufferPrep<T>(usage), fallback(fallback), mine({})
+{
+}
+
+template<class T>
+StreamPrep<T>::~StreamPrep()
+{
+    delete &fallback;
+}
+
+template<class T>
+void StreamPrep<T>::set_protocol(typename T::Protocol& protocol)
+{
+    fallback.set_protocol(protocol);
+}
+
+template<class T>
+void StreamPrep<T>::set_proc(SubProcessor<T>* proc)
+{
+    fallback.set_proc(proc);
+    if (proc and size_t(proc->Proc.thread_num) < streams.size())
+        mine = streams[proc->Proc.thread_num];
+}
+
+template<class T>
+void StreamPrep<T>::seekg(DataPositions& pos)
+{
+    // streamed tuples do not come from the fallback
+    DataPositions fallback_pos = pos;
+    for (auto& x : streams)
+        for (int dtype = 0; dtype < N_DTYPE; dtype++)
+            if (x[dtype])
+                fallback_pos.files[T::field_type()][dtype] = 0;
+    fallback.seekg(fallback_pos);
+}
+
+template<class T>
+void StreamPrep<T>::fetch(vector<array<T, 3>>& batch, Dtype dtype)
+{
+    if (not mine[dtype]->pop(batch))
+        throw runtime_error("in-process production of "
+                + string(DataPositions::dtype_names[dtype]) + " has stopped");
+}
+
+template<class T>
+void StreamPrep<T>::buffer_triples()
+{
+    fetch(this->triples, DATA_TRIPLE);
+}
+
+template<class T>
+void StreamPrep<T>::buffer_squares()
+{
+    vector<array<T, 3>> batch;
+    fetch(batch, DATA_SQUARE);
+    for (auto& x : batch)
+        this->squares.push_back({{x[0], x[1]}});
+}
+
+template<class T>
+void StreamPrep<T>::buffer_inverses()
+{
+    vector<array<T, 3>> batch;
+    fetch(batch, DATA_INVERSE);
+    for (auto& x : batch)
+        this->inverses.push_back({{x[0], x[1]}});
+}
+
+template<class T>
+void StreamPrep<T>::buffer_bits()
+{
+    vector<array<T, 3>> batch;
+    fetch(batch, DATA_BIT);
+    for (auto& x : batch)
+        this->bits.push_back(x[0]);
+}
+
+template<class T>
+void StreamPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
+{
+    if (mine[dtype])
+        BufferPrep<T>::get_three_no_count(dtype, a, b, c);
+    else
+        fallback.get_three_no_count(dtype, a, b, c);
+}
+
+template<class T>
+void StreamPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
+{
+    if (mine[dtype])
+        BufferPrep<T>::get_two_no_count(dtype, a, b);
+    else
+        fallback.get_two_no_count(dtype, a, b);
+}
+
+template<class T>
+void StreamPrep<T>::get_one_no_count(Dtype dtype, T& a)
+{
+    if (mine[dtype])
+        BufferPrep<T>::get_one_no_count(dtype, a);
+    else
+        fallback.get_one_no_count(dtype, a);
+}
+
+template<class T>
+void StreamPrep<T>::get_input_no_count(T& a, typename T::open_type& x, int i)
+{
+    fallback.get_input_no_count(a, x, i);
+}
+
+template<class T>
+void StreamPrep<T>::get_no_count(vector<T>& S, DataTag tag,
+        const vector<int>& regs, int vector_size)
+{
+    fallback.get_no_count(S, tag, regs, vector_size);
+}
+
+template<class T>
+void StreamPrep<T>::get_triples_no_count(vector<array<T, 3>>& triples, int n)
+{
+    if (mine[DATA_TRIPLE])
+        BufferPrep<T>::get_triples_no_count(triples, n);
+    else
+        fallback.get_triples_no_count(triples, n);
+}
@@ -5,7 +5,16 @@
 
 #include "Tools/Buffer.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 bool BufferBase::rewind = false;
+bool MappedBufferBase::rewind = false;
+
+// bytes to ask the kernel to fetch ahead of the read position
+#define READ_AHEAD (1 << 22)
 
 
 void BufferBase::setup(ifstream* f, int length, string filename,
@@ -73,3 +82,169 @@ void BufferBase::purge()
         file = 0;
     }
 }
+
+void MappedBufferBase::setup(string filename, int length, const char* type,
+        const char* field)
+{
+    tuple_length = length;
+    data_type = type;
+    field_type = field;
+    this->filename = filename;
+    up = true;
+    map();
+}
+
+void MappedBufferBase::map()
+{
+    offset = 0;
+    next_read_ahead = 0;
+    int fd = open(filename.c_str(), O_RDONLY);
+    exists = fd >= 0;
+    if (not exists)
+        return;
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+        ::close(fd);
+        throw file_error("cannot stat " + filename);
+    }
+    length = st.st_size;
+    if (length > 0)
+    {
+        void* res = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (res == MAP_FAILED)
+        {
+            ::close(fd);
+            throw file_error("cannot map " + filename);
+        }
+        data = (char*) res;
+        madvise(data, length, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+}
+
+void MappedBufferBase::unmap()
+{
+    if (data)
+        munmap(data, length);
+    data = 0;
+    length = 0;
+    offset = 0;
+}
+
+void MappedBufferBase::read_ahead()
+{
+    timer.start();
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t start = offset / page * page;
+    if (start < length)
+        madvise(data + start, min(size_t(READ_AHEAD), length - start),
+                MADV_WILLNEED);
+    next_read_ahead = offset + READ_AHEAD / 2;
+    timer.stop();
+}
+
+void MappedBufferBase::refill(size_t n_bytes)
+{
+    if (not exists)
+    {
+        stringstream ss;
+        ss << "IO problem when buffering " << field_type;
+        if (data_type.size())
+            ss << " " << data_type;
+        ss << " from " << filename;
+        throw file_error(ss.str());
+    }
+    try_rewind();
+    if (n_bytes > length)
+        throw runtime_error("file too short for one item: " + filename);
+}
+
+MappedBufferBase& MappedBufferBase::operator=(MappedBufferBase&& other)
+{
+    if (this != &other)
+    {
+        unmap();
+        data = other.data;
+        length = other.length;
+        offset = other.offset;
+        next_read_ahead = other.next_read_ahead;
+        exists = other.exists;
+        up = other.up;
+        tuple_length = other.tuple_length;
+        filename = move(other.filename);
+        data_type = move(other.data_type);
+        field_type = move(other.field_type);
+        timer = other.timer;
+        eof = other.eof;
+        other.data = 0;
+        other.length = 0;
+        other.offset = 0;
+        other.up = false;
+    }
+    return *this;
+}
+
+void MappedBufferBase::seekg(long long pos)
+{
+    offset = pos * tuple_length;
+    next_read_ahead = offset;
+    if (not exists or offset > length)
+    {
+        // let it go in case we don't need it anyway
+        if (pos != 0)
+            try_rewind();
+    }
+}
+
+void MappedBufferBase::try_rewind()
+{
+#ifndef INSECURE
+    string type;
+    if (field_type.size() and data_type.size())
+        type = (string)" of " + field_type + " " + data_type;
+    throw not_enough_to_buffer(type);
+#endif
+    if (length == 0)
+        throw runtime_error("empty file: " + filename);
+    offset = 0;
+    next_read_ahead = 0;
+    if (!rewind)
+        cerr << "REWINDING - ONLY FOR BENCHMARKING" << endl;
+    rewind = true;
+    eof = true;
+}
+
+void MappedBufferBase::prune()
+{
+    if (data and offset != 0)
+    {
+        cerr << "Pruning " << filename << endl;
+        string tmp_name = filename + ".new";
+        ofstream tmp(tmp_name.c_str(), ios::out | ios::binary);
+        if (offset < length)
+            tmp.write(data + offset, length - offset);
+        tmp.close();
+        unmap();
+        rename(tmp_name.c_str(), filename.c_str());
+        map();
+    }
+}
+
+void MappedBufferBase::purge()
+{
+    if (up)
+    {
+        cerr << "Removing " << filename << endl;
+        unlink(filename.c_str());
+        unmap();
+        exists = false;
+        up = false;
+    }
+}
+
+void MappedBufferBase::close()
+{
+    unmap();
+    up = false;
+}
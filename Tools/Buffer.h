@@ -59,28 +59,108 @@ public:
     void fill_buffer();
 };
 
-template<class U, class V>
-class BufferOwner : public Buffer<U, V>
+/*
+ * Read-only memory map of a preprocessing file. Seeking only sets the
+ * offset, and the kernel is asked to read ahead of the current
+ * position so that parsing rarely waits for the disk.
+ */
+class MappedBufferBase
 {
-    ifstream* file;
+protected:
+    static bool rewind;
+
+    char* data;
+    size_t length;
+    size_t offset;
+    size_t next_read_ahead;
+    bool exists, up;
+    int tuple_length;
+    string filename;
+    string data_type;
+    string field_type;
+    Timer timer;
+
+    void map();
+    void unmap();
+    void read_ahead();
+    void try_rewind();
+    void refill(size_t n_bytes);
 
 public:
-    BufferOwner() :
-            file(0)
+    bool eof;
+
+    MappedBufferBase() : data(0), length(0), offset(0), next_read_ahead(0),
+            exists(false), up(false), tuple_length(-1), eof(false) {}
+    ~MappedBufferBase() { unmap(); }
+
+    // only one instance may own a mapping
+    MappedBufferBase(const MappedBufferBase& other) = delete;
+    MappedBufferBase& operator=(const MappedBufferBase& other) = delete;
+    MappedBufferBase(MappedBufferBase&& other) : MappedBufferBase()
+    { *this = move(other); }
+    MappedBufferBase& operator=(MappedBufferBase&& other);
+
+    void setup(string filename, int length, const char* type = "",
+            const char* field = "");
+    void seekg(long long pos);
+    bool is_up() { return up; }
+    void prune();
+    void purge();
+    void close();
+};
+
+template<class U, class V>
+class BufferOwner : public MappedBufferBase
+{
+    static void parse(U& a, const char* buffer)
     {
+        if (U::size() == sizeof(U))
+            memcpy((char*)&a, buffer, sizeof(U));
+        else
+            a.assign(buffer);
     }
 
+public:
+    BufferOwner() {}
+    BufferOwner(BufferOwner&& other) = default;
+    ~BufferOwner();
+
     void setup(string filename, int tuple_length, const char* data_type = "")
     {
-        file = new ifstream(filename, ios::in | ios::binary);
-        Buffer<U, V>::setup(file, tuple_length, filename, data_type, U::type_string().c_str());
+        MappedBufferBase::setup(filename, tuple_length, data_type,
+                U::type_string().c_str());
     }
 
-    void close()
+    void input(V& a)
     {
-        if (file)
-            delete file;
-        file = 0;
+        if (offset + U::size() > length)
+            refill(U::size());
+        if (offset >= next_read_ahead)
+            read_ahead();
+        U tmp;
+        parse(tmp, data + offset);
+        a = tmp;
+        offset += U::size();
+    }
+
+    // parse n consecutive elements straight into the destination
+    void input(U* a, size_t n)
+    {
+        size_t n_bytes = n * U::size();
+        if (offset + n_bytes > length)
+        {
+            for (size_t i = 0; i < n; i++)
+                input(a[i]);
+            return;
+        }
+        if (offset + n_bytes >= next_read_ahead)
+            read_ahead();
+        if (U::size() == sizeof(U))
+            memcpy((char*)a, data + offset, n_bytes);
+        else
+            for (size_t i = 0; i < n; i++)
+                a[i].assign(data + offset + i * U::size());
+        offset += n_bytes;
     }
 };
 
@@ -153,4 +233,12 @@ inline void Buffer<T,U>::input(U& a)
     next++;
 }
 
+template<class U, class V>
+BufferOwner<U, V>::~BufferOwner()
+{
+    if (timer.elapsed() && data_type.size())
+        cerr << U::type_string() << " " << data_type << " reading: "
+                << timer.elapsed() << endl;
+}
+
 #endif /* TOOLS_BUFFER_H_ */
@@ -5,23 +5,120 @@
 
 #include "FlexBuffer.h"
 #include <iostream>
+#include <algorithm>
+#include <vector>
 #include <unistd.h>
 #include "BMR/network/utils.h"
 using namespace std;
 
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+
 #ifndef BUFFER_DIR
 #define BUFFER_DIR "/tmp"
 #endif
 
+size_t ReceivedMsgStore::memory_budget = 1L << 30;
+bool ReceivedMsgStore::compress = false;
+
+ReceivedMsgStore::ReceivedMsgStore() :
+		front_size(0), back_size(0), busy(false), running(true),
+		has_thread(false), thread(), total_size(0), spilled_size(0)
+{
+}
+
 ReceivedMsgStore::~ReceivedMsgStore()
 {
+	signal.lock();
+	running = false;
+	signal.broadcast();
+	signal.unlock();
+	if (has_thread)
+		pthread_join(thread, 0);
+	for (auto& filename : files)
+		remove(filename.c_str());
 #ifdef VERBOSE
 	cerr << "Stored " << (double)total_size / 1e9 << " GB in "
 			<< push_timer.elapsed() << " seconds and retrieved them in "
-			<< pop_timer.elapsed() << " seconds " << endl;
+			<< pop_timer.elapsed() << " seconds, "
+			<< (double)spilled_size / 1e9 << " GB via disk" << endl;
 #endif
 }
 
+size_t ReceivedMsgStore::chunk_size()
+{
+	return min(max(memory_budget / 4, size_t(1) << 20), size_t(1) << 28);
+}
+
+void ReceivedMsgStore::start_thread()
+{
+	if (not has_thread)
+	{
+		pthread_create(&thread, 0, run_thread, this);
+		has_thread = true;
+	}
+}
+
+// with lock, stops the background thread
+void ReceivedMsgStore::fail()
+{
+	error = current_exception();
+	busy = false;
+	signal.broadcast();
+}
+
+// with lock, released before rethrowing on the calling thread
+void ReceivedMsgStore::check_error()
+{
+	if (error)
+	{
+		signal.unlock();
+		rethrow_exception(error);
+	}
+}
+
+void* ReceivedMsgStore::run_thread(void* store)
+{
+	((ReceivedMsgStore*)store)->run();
+	return 0;
+}
+
+void ReceivedMsgStore::run()
+{
+	signal.lock();
+	while (running and not error)
+	{
+		if (not files.empty()
+				and (front.empty() or front_size < memory_budget / 4))
+			prefetch();
+		else if (back_size >= chunk_size())
+			spill();
+		else
+			signal.wait();
+	}
+	signal.unlock();
+}
+
+// move from back to front if nothing in between,
+// front and a chunk being prefetched use half of the budget
+void ReceivedMsgStore::settle()
+{
+	if (error)
+		return;
+	while (files.empty() and not busy and not back.empty()
+			and (front.empty()
+					or front_size + back.front().size() <= memory_budget / 2))
+	{
+		size_t size = back.front().size();
+		front.push_back({});
+		front.back() = back.front();
+		back.pop_front();
+		back_size -= size;
+		front_size += size;
+	}
+}
+
 void ReceivedMsgStore::push(ReceivedMsg& msg)
 {
 #ifdef DEBUG_STORE
@@ -29,81 +126,288 @@ void ReceivedMsgStore::push(ReceivedMsg& msg)
     //phex(msg.data(), min(100UL, msg.size()));
 #endif
     TimeScope ts(push_timer);
-	total_size += msg.size();
-	if (mem_size != N and files.empty())
-	{
-		mem[(start + mem_size) % N] = msg;
-		mem_size++;
-	}
-	else
+	signal.lock();
+	// wait for the background thread to catch up,
+	// back including a chunk being spilled uses the other half
+	while (back_size >= max(memory_budget / 2, chunk_size()))
 	{
-		char filename[1000];
-		sprintf(filename, "%s/%d.XXXXXX", BUFFER_DIR, getpid());
-		FILE* file = fdopen(mkstemp(filename), "w");
-		if (!file)
-			throw runtime_error("can't open file");
-		size_t len = msg.size();
-		size_t ptr = msg.ptr - msg.buf;
-		if (fwrite(&len, sizeof(len), 1, file) != 1)
-			throw runtime_error("can't write");
-		if (fwrite(&ptr, sizeof(len), 1, file) != 1)
-			throw runtime_error("can't write");
-		if (len != 0)
-		    if (fwrite(msg.data(), msg.size(), 1, file) != 1)
-		        throw runtime_error("can't write");
-		if (fclose(file) != 0)
-			throw runtime_error("can't close");
-		files.push_back(filename);
+		check_error();
+		signal.wait();
 	}
+	check_error();
+	total_size += msg.size();
+	back_size += msg.size();
+	back.push_back({});
+	back.back() = msg;
+	settle();
+	if (not back.empty())
+		start_thread();
+	signal.broadcast();
+	signal.unlock();
 }
 
 bool ReceivedMsgStore::pop(ReceivedMsg& msg)
 {
 	TimeScope ts(pop_timer);
-	if (mem_size != 0)
+	signal.lock();
+	check_error();
+	settle();
+	while (front.empty() and (busy or not files.empty()))
+	{
+		check_error();
+		signal.wait();
+		settle();
+	}
+	bool res = not front.empty();
+	if (res)
 	{
-		msg = mem[start];
-		start = (start + 1) % N;
-		mem_size--;
+		msg = front.front();
+		front.pop_front();
+		front_size -= msg.size();
 #ifdef DEBUG_STORE
-	    cout << "popping from memory msg of length " << msg.size() << endl;
+	    cout << "popping msg of length " << msg.size() << endl;
 	    //phex(msg.data(), min(100UL, msg.size()));
 #endif
-		return true;
 	}
-	else if (!files.empty())
+	signal.broadcast();
+	signal.unlock();
+	return res;
+}
+
+bool ReceivedMsgStore::empty()
+{
+	signal.lock();
+	check_error();
+	bool res = front.empty() and back.empty() and files.empty() and not busy;
+	signal.unlock();
+	return res;
+}
+
+template<class T>
+void write_all(const T* data, size_t n, FILE* file)
+{
+	if (n != 0)
+		if (fwrite(data, sizeof(T), n, file) != n)
+			throw runtime_error("can't write");
+}
+
+template<class T>
+void read_all(T* data, size_t n, FILE* file)
+{
+	if (n != 0)
+		if (fread(data, sizeof(T), n, file) != n)
+		{
+			perror("can't read");
+			throw runtime_error("can't read");
+		}
+}
+
+// chunk format: number of messages, compressed size (0 if not
+// compressed), then length, head position, and data of every message
+void ReceivedMsgStore::write_chunk(FILE* file, deque<ReceivedMsg>& chunk,
+		size_t size)
+{
+	if (!file)
+		throw runtime_error("can't open file");
+	size_t header[] = { chunk.size(), 0 };
+#ifdef USE_LZ4
+	size_t raw_size = size + 2 * sizeof(size_t) * chunk.size();
+	if (compress and raw_size <= LZ4_MAX_INPUT_SIZE)
+	{
+		vector<char> raw(raw_size);
+		char* pos = raw.data();
+		for (auto& msg : chunk)
+		{
+			size_t meta[] = { msg.size(), size_t(msg.ptr - msg.buf) };
+			memcpy(pos, meta, sizeof(meta));
+			memcpy(pos + sizeof(meta), msg.data(), msg.size());
+			pos += sizeof(meta) + msg.size();
+		}
+		chunk.clear();
+		vector<char> compressed(LZ4_compressBound(raw_size));
+		header[1] = LZ4_compress_default(raw.data(), compressed.data(),
+				raw_size, compressed.size());
+		if (header[1] == 0)
+			throw runtime_error("compression failed");
+		write_all(header, 2, file);
+		write_all(&raw_size, 1, file);
+		write_all(compressed.data(), header[1], file);
+	}
+	else
+#else
+	(void) size;
+#endif
+	{
+		write_all(header, 2, file);
+		for (auto& msg : chunk)
+		{
+			size_t meta[] = { msg.size(), size_t(msg.ptr - msg.buf) };
+			write_all(meta, 2, file);
+			write_all(msg.data(), msg.size(), file);
+		}
+	}
+	if (fclose(file) != 0)
+		throw runtime_error("can't close");
+}
+
+size_t ReceivedMsgStore::read_chunk(const string& filename,
+		deque<ReceivedMsg>& chunk)
+{
+	FILE* file = fopen(filename.c_str(), "r");
+	if (!file)
+		throw runtime_error("can't open " + filename);
+	size_t header[2];
+	read_all(header, 2, file);
+	chunk.resize(header[0]);
+	size_t size = 0;
+	if (header[1] != 0)
 	{
-		string filename = files.front();
-		FILE* file = fopen(filename.c_str(), "r");
-		files.pop_front();
-		fseek(file, 0, SEEK_SET);
-		size_t len;
-		if (fread(&len, sizeof(len), 1, file) != 1)
+#ifdef USE_LZ4
+		size_t raw_size;
+		read_all(&raw_size, 1, file);
+		vector<char> compressed(header[1]), raw(raw_size);
+		read_all(compressed.data(), header[1], file);
+		if (LZ4_decompress_safe(compressed.data(), raw.data(), header[1],
+				raw_size) != int(raw_size))
+			throw runtime_error("decompression failed");
+		char* pos = raw.data();
+		for (auto& msg : chunk)
 		{
-			perror("can't read length");
-			throw runtime_error("can't read length");
+			size_t meta[2];
+			memcpy(meta, pos, sizeof(meta));
+			msg.resize(meta[0]);
+			msg.ptr = msg.buf + meta[1];
+			memcpy(msg.data(), pos + sizeof(meta), meta[0]);
+			pos += sizeof(meta) + meta[0];
+			size += meta[0];
 		}
-		msg.resize(len);
-		size_t ptr;
-		if (fread(&ptr, sizeof(len), 1, file) != 1)
+#else
+		throw runtime_error("compiled without LZ4 support");
+#endif
+	}
+	else
+		for (auto& msg : chunk)
 		{
-			perror("can't read length");
-			throw runtime_error("can't read length");
+			size_t meta[2];
+			read_all(meta, 2, file);
+			msg.resize(meta[0]);
+			msg.ptr = msg.buf + meta[1];
+			read_all(msg.data(), meta[0], file);
+			size += meta[0];
 		}
-		msg.ptr = msg.buf + ptr;
-		if (len != 0)
-		    if (fread(msg.data(), len, 1, file) != 1)
-		    {
-		        perror("can't read data");
-		        throw runtime_error("can't read data");
-		    }
-		fclose(file);
+	fclose(file);
+	return size;
+}
+
+void ReceivedMsgStore::spill()
+{
+	deque<ReceivedMsg> chunk;
+	size_t size = 0;
+	while (not back.empty() and (chunk.empty() or size < chunk_size()))
+	{
+		size += back.front().size();
+		chunk.push_back({});
+		chunk.back() = back.front();
+		back.pop_front();
+	}
+	busy = true;
+	signal.unlock();
+
+	char filename[1000];
+	sprintf(filename, "%s/%d.XXXXXX", BUFFER_DIR, getpid());
+	try
+	{
+		write_chunk(fdopen(mkstemp(filename), "w"), chunk, size);
+	}
+	catch (...)
+	{
+		signal.lock();
+		fail();
+		return;
+	}
+
+	signal.lock();
+	files.push_back(filename);
+	back_size -= size;
+	spilled_size += size;
+	busy = false;
+	signal.broadcast();
+}
+
+void ReceivedMsgStore::prefetch()
+{
+	string filename = files.front();
+	files.pop_front();
+	busy = true;
+	signal.unlock();
+
+	deque<ReceivedMsg> chunk;
+	size_t size;
+	try
+	{
+		size = read_chunk(filename, chunk);
+	}
+	catch (...)
+	{
 		remove(filename.c_str());
-#ifdef DEBUG_FLEXBUF
-        cout << "popping from disk msg of length " << msg.size() << endl;
-        phex(msg.data(), min(100UL, msg.size()));
-#endif
-		return true;
+		signal.lock();
+		fail();
+		return;
+	}
+	remove(filename.c_str());
+
+	signal.lock();
+	for (auto& msg : chunk)
+	{
+		front.push_back({});
+		front.back() = msg;
+	}
+	front_size += size;
+	busy = false;
+	settle();
+	signal.broadcast();
+}
+
+void ReceivedMsgStore::save(const string& dir)
+{
+	deque<ReceivedMsg> chunk;
+	size_t size = 0;
+	int n_chunks = 0;
+	ReceivedMsg msg;
+	while (pop(msg))
+	{
+		size += msg.size();
+		chunk.push_back({});
+		chunk.back() = msg;
+		if (size >= chunk_size())
+		{
+			string filename = dir + "/" + to_string(n_chunks++);
+			write_chunk(fopen(filename.c_str(), "w"), chunk, size);
+			chunk.clear();
+			size = 0;
+		}
+	}
+	if (not chunk.empty())
+	{
+		string filename = dir + "/" + to_string(n_chunks++);
+		write_chunk(fopen(filename.c_str(), "w"), chunk, size);
+	}
+}
+
+void ReceivedMsgStore::load(const string& dir)
+{
+	if (not empty())
+		throw runtime_error("can only load into empty store");
+	signal.lock();
+	for (int i = 0;; i++)
+	{
+		string filename = dir + "/" + to_string(i);
+		if (access(filename.c_str(), R_OK) != 0)
+			break;
+		files.push_back(filename);
 	}
-	return false;
+	if (not files.empty())
+		start_thread();
+	signal.broadcast();
+	signal.unlock();
 }
@@ -9,8 +9,10 @@
 #include "Tools/avx_memcpy.h"
 #include "Tools/time-func.h"
 #include "Tools/octetStream.h"
+#include "Tools/Signal.h"
 #include <stdio.h>
 #include <stdexcept>
+#include <exception>
 #include <deque>
 #include <iostream>
 using namespace std;
@@ -81,21 +83,62 @@ class LocalBuffer : public ReceivedMsg, public SendBuffer
 {
 };
 
+/*
+ * FIFO of messages keeping up to memory_budget bytes in memory.
+ * Beyond that, a background thread spills messages to disk in large
+ * sequential chunks and prefetches them before they are popped.
+ * Messages are in order: front, files, back.
+ * The budget applies to every store separately and is split evenly
+ * between front (including a chunk being read) and back (including a
+ * chunk being written). Chunks are at least 1 MB, so a store holds at
+ * most the larger of memory_budget and 4 MB plus a few messages.
+ * I/O errors in the background thread are rethrown by the next call
+ * of push(), pop(), or empty().
+ */
 class ReceivedMsgStore
 {
-	static const int N = 1;
-	ReceivedMsg mem[N];
-	int start, mem_size;
+	deque<ReceivedMsg> front, back;
 	deque<string> files;
-	size_t total_size;
+	size_t front_size, back_size;
+	// I/O outside the lock, files and queues are not in order
+	bool busy;
+	bool running;
+	bool has_thread;
+	pthread_t thread;
+	Signal signal;
+	size_t total_size, spilled_size;
 	Timer push_timer, pop_timer;
+	exception_ptr error;
+
+	static void* run_thread(void* store);
+	void run();
+	void settle();
+	void spill();
+	void prefetch();
+	void start_thread();
+	void fail();
+	void check_error();
+
+	size_t chunk_size();
+
+	static void write_chunk(FILE* file, deque<ReceivedMsg>& chunk, size_t size);
+	static size_t read_chunk(const string& filename, deque<ReceivedMsg>& chunk);
+
 public:
-	ReceivedMsgStore() : start(0), mem_size(0), total_size(0) {}
+	static size_t memory_budget;
+	static bool compress;
+
+	ReceivedMsgStore();
 	~ReceivedMsgStore();
 	void push(ReceivedMsg& msg);
 	void push_and_clear(LocalBuffer& msg) { push(msg); msg.clear(); }
 	bool pop(ReceivedMsg& msg);
-	bool empty() { return mem_size == 0 and files.empty(); }
+	bool empty();
+
+	// move everything to chunk files in existing directory
+	void save(const string& dir);
+	// queue chunk files from save(), removed after reading
+	void load(const string& dir);
 };
 
 inline FlexBuffer::FlexBuffer(const FlexBuffer& msg)
@@ -11,11 +11,17 @@ using namespace std;
 
 
 OfflineMachineBase::OfflineMachineBase() :
-        server(0), my_num(0), nplayers(0), ntriples(0),
+        server(0), N(own_N), my_num(0), nplayers(0), ntriples(0),
         nTriplesPerThread(0)
 {
 }
 
+OfflineMachineBase::OfflineMachineBase(Names& N) :
+        server(0), N(N), my_num(N.my_num()), nplayers(N.num_players()),
+        ntriples(0), nTriplesPerThread(0)
+{
+}
+
 OfflineMachineBase::~OfflineMachineBase()
 {
     if (server)
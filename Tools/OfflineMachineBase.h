@@ -24,13 +24,16 @@ class OfflineMachineBase : virtual public OfflineParams
 protected:
     ez::ezOptionParser opt;
     Server* server;
+    Names own_N;
 
 public:
-    Names N;
+    Names& N;
     int my_num, nplayers;
     long long ntriples, nTriplesPerThread;
 
     OfflineMachineBase();
+    // use the network setup of another machine in the same process
+    OfflineMachineBase(Names& N);
     ~OfflineMachineBase();
 
     void parse_options(int argc, const char** argv);
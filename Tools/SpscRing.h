@@ -0,0 +1,97 @@
+/*
+ * SpscRing.h
+ *
+ */
+
+#ifndef TOOLS_SPSCRING_H_
+#define TOOLS_SPSCRING_H_
+
+#include <atomic>
+#include <vector>
+#include <array>
+#include <thread>
+#include <chrono>
+using namespace std;
+
+class SpscRingBase
+{
+protected:
+    atomic<bool> closed;
+
+public:
+    SpscRingBase() : closed(false) {}
+    virtual ~SpscRingBase() {}
+
+    // pushing fails afterwards, popping once the ring is empty
+    void close() { closed = true; }
+    bool is_closed() { return closed; }
+};
+
+/*
+ * Bounded ring for exactly one producing and one consuming thread.
+ * Each position is only advanced by its owner, so neither side takes
+ * a lock. Waiting starts with spinning and falls back to sleeping
+ * because either side might have to wait for a long time.
+ */
+template<class T>
+class SpscRing : public SpscRingBase
+{
+    vector<T> items;
+    // next to pop and next to push, on separate cache lines
+    atomic<size_t> head;
+    char padding[64];
+    atomic<size_t> tail;
+
+    size_t next(size_t pos) { return (pos + 1) % items.size(); }
+
+    template<class U>
+    bool wait(U ready)
+    {
+        for (int i = 0; not ready(); i++)
+        {
+            if (closed)
+                return ready();
+            if (i > 1000)
+                this_thread::sleep_for(chrono::microseconds(100));
+            else if (i > 100)
+                this_thread::yield();
+        }
+        return true;
+    }
+
+public:
+    SpscRing(size_t capacity = 4) :
+            items(capacity + 1), head(0), tail(0)
+    {
+    }
+
+    // moves from item, blocks while full
+    bool push(T& item)
+    {
+        size_t pos = tail.load(memory_order_relaxed);
+        if (not wait([&]() { return next(pos) != head.load(memory_order_acquire); }))
+            return false;
+        if (closed)
+            return false;
+        items[pos] = move(item);
+        tail.store(next(pos), memory_order_release);
+        return true;
+    }
+
+    // blocks while empty
+    bool pop(T& item)
+    {
+        size_t pos = head.load(memory_order_relaxed);
+        if (not wait([&]() { return pos != tail.load(memory_order_acquire); }))
+            return false;
+        item = move(items[pos]);
+        head.store(next(pos), memory_order_release);
+        return true;
+    }
+};
+
+// tuples of up to three shares, unused entries for pairs and single shares
+template<class T>
+using TupleStream = SpscRing<vector<array<T, 3>>>;
+
+#endif /* TOOLS_SPSCRING_H_ */
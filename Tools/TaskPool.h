@@ -0,0 +1,162 @@
+/*
+ * TaskPool.h
+ *
+ */
+
+#ifndef TOOLS_TASKPOOL_H_
+#define TOOLS_TASKPOOL_H_
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <exception>
+#include <pthread.h>
+using namespace std;
+
+#include "Tools/Signal.h"
+
+/*
+ * Tasks shared between all threads of a machine such as a
+ * binary-circuit machine. Threads run tasks whenever they wait for
+ * something (a tape to run, another thread to finish, or their own
+ * tasks), so that idle threads help busy ones. All conditions are
+ * evaluated under the pool lock. Optionally, the pool has worker
+ * threads that do nothing but run tasks.
+ */
+class TaskPool
+{
+    struct Task
+    {
+        function<void()> job;
+        const void* owner;
+        int* pending;
+        exception_ptr* error;
+    };
+
+    Signal signal;
+    deque<Task> tasks;
+
+    vector<pthread_t> workers;
+    bool done;
+
+    // run a task without holding the lock,
+    // an exception is stored for the owner to rethrow
+    void run(deque<Task>::iterator it)
+    {
+        Task task = *it;
+        tasks.erase(it);
+        signal.unlock();
+        exception_ptr error;
+        try
+        {
+            task.job();
+        }
+        catch (...)
+        {
+            error = current_exception();
+        }
+        signal.lock();
+        if (error and not *task.error)
+            *task.error = error;
+        (*task.pending)--;
+        signal.broadcast();
+    }
+
+    static void* run_worker(void* pool)
+    {
+        auto& self = *(TaskPool*) pool;
+        self.help_until([&]() { return self.done; });
+        return 0;
+    }
+
+public:
+    TaskPool() : done(false) {}
+
+    ~TaskPool()
+    {
+        update([this]() { done = true; });
+        for (auto& thread : workers)
+            pthread_join(thread, 0);
+    }
+
+    void start_workers(int n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            workers.push_back({});
+            pthread_create(&workers.back(), 0, run_worker, this);
+        }
+    }
+
+    int n_workers() { return workers.size(); }
+
+    // pending and error have to outlive the task, see wait()
+    void push(function<void()> job, const void* owner, int& pending,
+            exception_ptr& error)
+    {
+        signal.lock();
+        tasks.push_back({job, owner, &pending, &error});
+        pending++;
+        signal.broadcast();
+        signal.unlock();
+    }
+
+    // run tasks until condition holds, only those of owner if given
+    void help_until(function<bool()> condition, const void* owner = 0)
+    {
+        signal.lock();
+        while (not condition())
+        {
+            auto it = tasks.begin();
+            while (owner and it != tasks.end() and it->owner != owner)
+                it++;
+            if (it == tasks.end())
+                signal.wait();
+            else
+                run(it);
+        }
+        signal.unlock();
+    }
+
+    // run tasks of owner until all have finished,
+    // then rethrow the first exception if any
+    void wait(const void* owner, int& pending, exception_ptr& error)
+    {
+        help_until([&]() { return pending == 0; }, owner);
+        if (error)
+            rethrow_exception(error);
+    }
+
+    // change state that others are waiting for
+    void update(function<void()> change)
+    {
+        signal.lock();
+        change();
+        signal.broadcast();
+        signal.unlock();
+    }
+
+    // run f(0), ..., f(n - 1), helped by other threads,
+    // rethrows the first exception once all calls have finished
+    void parallel_for(size_t n, function<void(size_t)> f)
+    {
+        int pending = 0;
+        exception_ptr error;
+        for (size_t i = 1; i < n; i++)
+            push([&f, i]() { f(i); }, &pending, pending, error);
+        if (n > 0)
+        {
+            try
+            {
+                f(0);
+            }
+            catch (...)
+            {
+                update([&]() { if (not error) error = current_exception(); });
+            }
+        }
+        wait(&pending, pending, error);
+    }
+};
+
+#endif /* TOOLS_TASKPOOL_H_ */
@@ -49,6 +49,9 @@ public:
 		n_jobs = 0;
 	}
 
+	// A running job is finished before joining, so the owner has to
+	// make sure that it returns, for example by the other side of a
+	// blocking exchange sending or closing the connection.
 	~Worker()
 	{
 		input.stop();
@@ -68,4 +68,36 @@ inline bool cpu_has_aes()
 #endif
 }
 
+inline bool os_has_avx512()
+{
+    if (not check_cpu(1, true, 27))
+        return false;
+    // opmask and all ZMM state enabled by the OS
+    unsigned int ax, dx;
+    __asm__ __volatile__ ("xgetbv" : "=a" (ax), "=d" (dx) : "c" (0));
+    return (ax & 0xe6) == 0xe6;
+}
+
+// AVX-512 F/DQ, always checked at runtime
+inline bool cpu_has_avx512dq()
+{
+    return check_cpu(7, false, 16) and check_cpu(7, false, 17)
+            and os_has_avx512();
+}
+
+// AVX-512 F/BW/VBMI and GFNI, always checked at runtime
+inline bool cpu_has_avx512_gfni()
+{
+    return check_cpu(7, false, 16) and check_cpu(7, false, 30)
+            and check_cpu(7, true, 1) and check_cpu(7, true, 8)
+            and os_has_avx512();
+}
+
+// AVX-512 F and vector AES, always checked at runtime
+inline bool cpu_has_vaes()
+{
+    return check_cpu(7, false, 16) and check_cpu(7, true, 9)
+            and os_has_avx512();
+}
+
 #endif /* TOOLS_CPU_SUPPORT_H_ */
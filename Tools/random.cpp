@@ -162,7 +162,8 @@ unsigned int PRNG::get_uint(int upper)
 	// not power of 2
 	int r, reduced;
 	do {
-		r = (upper < 255) ? get_uchar() : get_uint();
+		// non-negative like Java's next(31)
+		r = (upper < 255) ? get_uchar() : get_uint() >> 1;
 		reduced = r % upper;
 	} while (r - reduced + (upper - 1) < 0);
 	return reduced;
@@ -0,0 +1,53 @@
+/*
+ * sha256.cpp
+ *
+ */
+
+#include "sha256.h"
+#include "octetStream.h"
+#include "Exceptions/Exceptions.h"
+
+// renamed in OpenSSL 1.1
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define EVP_MD_CTX_new EVP_MD_CTX_create
+#define EVP_MD_CTX_free EVP_MD_CTX_destroy
+#endif
+
+SHA256Hash::SHA256Hash() :
+        ctx(EVP_MD_CTX_new())
+{
+    if (ctx == 0)
+        throw runtime_error("cannot allocate SHA-256 context");
+    reset();
+}
+
+SHA256Hash::~SHA256Hash()
+{
+    EVP_MD_CTX_free(ctx);
+}
+
+void SHA256Hash::reset()
+{
+    if (EVP_DigestInit_ex(ctx, EVP_sha256(), 0) != 1)
+        throw runtime_error("SHA-256 initialization failed");
+    size = 0;
+}
+
+void SHA256Hash::update(const void* dataIn, unsigned long len)
+{
+    if (EVP_DigestUpdate(ctx, dataIn, len) != 1)
+        throw runtime_error("SHA-256 update failed");
+    size += len;
+}
+
+void SHA256Hash::update(const octetStream& os)
+{
+    update(os.get_data(), os.get_length());
+}
+
+void SHA256Hash::final(unsigned char hashout[hash_length])
+{
+    if (EVP_DigestFinal_ex(ctx, hashout, 0) != 1)
+        throw runtime_error("SHA-256 finalization failed");
+    reset();
+}
@@ -0,0 +1,41 @@
+/*
+ * sha256.h
+ *
+ */
+
+#ifndef TOOLS_SHA256_H_
+#define TOOLS_SHA256_H_
+
+#include <openssl/evp.h>
+
+class octetStream;
+
+/*
+ * Incremental SHA-256 using OpenSSL, which selects SHA-NI or AVX2
+ * code depending on the CPU.
+ */
+class SHA256Hash
+{
+    EVP_MD_CTX* ctx;
+
+    // prevent copying
+    SHA256Hash(const SHA256Hash& other);
+    SHA256Hash& operator=(const SHA256Hash& other);
+
+public:
+    static const int hash_length = 32;
+
+    // number of bytes hashed since the last reset
+    unsigned long long size;
+
+    SHA256Hash();
+    ~SHA256Hash();
+
+    void reset();
+    void update(const void *dataIn, unsigned long len);
+    void update(const octetStream& os);
+    // resets the state
+    void final(unsigned char hashout[hash_length]);
+};
+
+#endif /* TOOLS_SHA256_H_ */
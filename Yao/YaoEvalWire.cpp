@@ -39,9 +39,9 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 	Key* labels;
 	Key* hashes;
 	vector<Key> label_vec, hash_vec;
-	size_t n_hashes = total_ands;
-	Key label_arr[1000], hash_arr[1000];
-	if (total_ands < 1000)
+	size_t n_hashes = YaoGate::N_EVAL_HASHES * total_ands;
+	Key label_arr[2000], hash_arr[2000];
+	if (n_hashes <= 2000)
 	{
 		labels = label_arr;
 		hashes = hash_arr;
@@ -66,8 +66,15 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 			auto& left_wire = left.get_reg(k);
 			auto& right_key = right.get_reg(repeat ? 0 : k).key;
 			evaluator.counter++;
+#ifdef HALF_GATES
+			labels[i_label++] = YaoGate::E_input(left_wire.key,
+					evaluator.get_gate_id(), 0);
+			labels[i_label++] = YaoGate::E_input(right_key,
+					evaluator.get_gate_id(), 1);
+#else
 			labels[i_label++] = YaoGate::E_input(left_wire.key, right_key,
 					evaluator.get_gate_id());
+#endif
 		}
 	}
 	MMO& mmo = evaluator.mmo;
@@ -91,8 +98,13 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 			auto& left_wire = left.get_reg(k);
 			YaoGate gate;
 			evaluator.load_gate(gate);
+#ifdef HALF_GATES
+			gate.eval(out.get_reg(k), &hashes[j], left_wire, right_wire);
+			j += 2;
+#else
 			gate.eval(out.get_reg(k), hashes[j++],
 					gate.get_entry(left_wire.external, right_wire.external));
+#endif
 		}
 	}
 }
@@ -144,11 +144,20 @@ void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 			auto& left_wire = S[args[i + 2]].get_reg(k);
 			const Key& right_key = S[args[i + 3]].get_reg(repeat ? 0 : k).key;
 			counter++;
+#ifdef HALF_GATES
+			for (int i = 0; i < 2; i++)
+				labels[i_label++] = YaoGate::E_input(
+						left_wire.key ^ (i ? delta : 0), counter, 0);
+			for (int j = 0; j < 2; j++)
+				labels[i_label++] = YaoGate::E_input(
+						right_key ^ (j ? delta : 0), counter, 1);
+#else
 			for (int i = 0; i < 2; i++)
 				for (int j = 0; j < 2; j++)
 					labels[i_label++] = YaoGate::E_input(
 							left_wire.key ^ (i ? delta : 0),
 							right_key ^ (j ? delta : 0), counter);
+#endif
 		}
 	}
 	//timers["Hash input"].stop();
@@ -177,12 +186,19 @@ void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 			//timers["Inner ref"].start();
 			auto& left_wire = S[args[i + 2]].get_reg(k);
 			//timers["Inner ref"].stop();
+#ifdef HALF_GATES
+			(void)prng;
+			// output label is derived from the hashes
+			(gate++)->garble(out.get_reg(k), &hashes[i_hash], left_wire,
+					right_wire.mask, garbler.get_delta());
+#else
 			//timers["Randomizing"].start();
 			out.get_reg(k).randomize(prng);
 			//timers["Randomizing"].stop();
 			//timers["Gate computation"].start();
 			(gate++)->garble(out.get_reg(k), &hashes[i_hash], left_wire.mask,
 					right_wire.mask, 0x0001, garbler.get_delta());
+#endif
 			//timers["Gate computation"].stop();
 			i_hash += 4;
 		}
@@ -243,8 +259,9 @@ inline void YaoGarbler::store_gate(const YaoGate& gate)
 void YaoGarbleWire::op(const YaoGarbleWire& left, const YaoGarbleWire& right,
 		Function func)
 {
-	auto& garbler = YaoGarbler::s();
-	randomize(garbler.prng);
+#ifndef HALF_GATES
+	randomize(YaoGarbler::s().prng);
+#endif
 	YaoGarbler::s().counter++;
 	YaoGate gate(*this, left, right, func);
 	YaoGarbler::s().store_gate(gate);
@@ -9,12 +9,25 @@
 #include "BMR/prf.h"
 #include "Tools/MMO.h"
 
-YaoGate::YaoGate(const YaoGarbleWire& out, const YaoGarbleWire& left,
+YaoGate::YaoGate(YaoGarbleWire& out, const YaoGarbleWire& left,
 		const YaoGarbleWire& right, Function func)
 {
 	const Key& delta = YaoGarbler::s().get_delta();
 	MMO& mmo = YaoGarbler::s().mmo;
 	Key hashes[4];
+#ifdef HALF_GATES
+	if (func.call(0, 0) or func.call(0, 1) or func.call(1, 0)
+			or not func.call(1, 1))
+		throw not_implemented();
+	for (int i = 0; i < 2; i++)
+	{
+		hashes[i] = mmo.hash(E_input(left.key ^ (i ? delta : 0),
+				YaoGarbler::s().get_gate_id(), 0));
+		hashes[2 + i] = mmo.hash(E_input(right.key ^ (i ? delta : 0),
+				YaoGarbler::s().get_gate_id(), 1));
+	}
+	garble(out, hashes, left, right.mask, delta);
+#else
 	for (int i = 0; i < 2; i++)
 		for (int j = 0; j < 2; j++)
 			hashes[2 * i + j] = mmo.hash(
@@ -22,6 +35,7 @@ YaoGate::YaoGate(const YaoGarbleWire& out, const YaoGarbleWire& left,
 							right.key ^ (j ? delta : 0),
 							YaoGarbler::s().get_gate_id()));
 	garble(out, hashes, left.mask, right.mask, func, delta);
+#endif
 #ifdef DEBUG
 	cout << "left " << left.mask << " " << left.key << " " << (left.key ^ delta) << endl;
 	cout << "right " << right.mask << " " << right.key << " " << (right.key ^ delta) << endl;
@@ -32,11 +46,17 @@ YaoGate::YaoGate(const YaoGarbleWire& out, const YaoGarbleWire& left,
 void YaoGate::eval(YaoEvalWire& out, const YaoEvalWire& left, const YaoEvalWire& right)
 {
 	MMO& mmo = YaoEvaluator::s().mmo;
+#ifdef HALF_GATES
+	Key hashes[2];
+	hashes[0] = mmo.hash(E_input(left.key, YaoEvaluator::s().get_gate_id(), 0));
+	hashes[1] = mmo.hash(E_input(right.key, YaoEvaluator::s().get_gate_id(), 1));
+	eval(out, hashes, left, right);
+#else
 	Key key = E_input(left.key, right.key, YaoEvaluator::s().get_gate_id());
 	eval(out, mmo.hash(key), get_entry(left.external, right.external));
+#endif
 #ifdef DEBUG
 	cout << "external " << left.external << " " << right.external << endl;
-	cout << "entry " << get_entry(left.external, right.external) << endl;
 	cout << "out " << out.key << endl;
 #endif
 }
@@ -13,19 +13,37 @@
 
 class YaoGate
 {
+#ifdef HALF_GATES
+	Key entries[2];
+#else
 	Key entries[2][2];
+#endif
 public:
+	// number of hashes per gate on evaluation
+#ifdef HALF_GATES
+	static const int N_EVAL_HASHES = 2;
+#else
+	static const int N_EVAL_HASHES = 1;
+#endif
+
 	static Key E_input(const Key& left, const Key& right, long T);
+	static Key E_input(const Key& key, long T, int half);
 
 	YaoGate() {}
-	YaoGate(const YaoGarbleWire& out, const YaoGarbleWire& left,
+	YaoGate(YaoGarbleWire& out, const YaoGarbleWire& left,
 			const YaoGarbleWire& right, Function func);
 	void garble(const YaoGarbleWire& out, const Key* hashes, bool left_mask,
 			bool right_mask, Function func, Key delta);
+	void garble(YaoGarbleWire& out, const Key* hashes,
+			const YaoGarbleWire& left, bool right_mask, Key delta);
 	void eval(YaoEvalWire& out, const YaoEvalWire& left, const YaoEvalWire& right);
 	void eval(YaoEvalWire& out, const Key& hash,
 			const Key& entry);
+	void eval(YaoEvalWire& out, const Key* hashes, const YaoEvalWire& left,
+			const YaoEvalWire& right);
+#ifndef HALF_GATES
 	const Key& get_entry(bool left, bool right) { return entries[left][right]; }
+#endif
 };
 
 inline Key YaoGate::E_input(const Key& left, const Key& right, long T)
@@ -38,6 +56,12 @@ inline Key YaoGate::E_input(const Key& left, const Key& right, long T)
 	return res;
 }
 
+inline Key YaoGate::E_input(const Key& key, long T, int half)
+{
+	return key.doubling(1) ^ Key(half, T);
+}
+
+#ifndef HALF_GATES
 inline void YaoGate::garble(const YaoGarbleWire& out, const Key* hashes,
 		bool left_mask, bool right_mask, Function func, Key delta)
 {
@@ -73,5 +97,37 @@ inline void YaoGate::eval(YaoEvalWire& out, const Key& hash, const Key& entry)
 #endif
 	out.set(key);
 }
+#else
+/*
+ * Half-gates AND garbling. The hashes are of the left labels with
+ * signal bit zero and one using the first tweak and of the right
+ * labels using the second tweak. The output wire is determined by the
+ * hashes.
+ */
+inline void YaoGate::garble(YaoGarbleWire& out, const Key* hashes,
+		const YaoGarbleWire& left, bool right_mask, Key delta)
+{
+	Key left_zero = left.key ^ (left.mask ? delta : 0);
+	entries[0] = hashes[0] ^ hashes[1] ^ (right_mask ? delta : 0);
+	entries[1] = hashes[2] ^ hashes[3] ^ left_zero;
+	Key out_zero = hashes[0] ^ hashes[2] ^ (left.mask and right_mask ? delta : 0);
+	bool out_mask = out_zero.get_signal();
+	out.set(out_zero ^ (out_mask ? delta : 0), out_mask);
+#ifdef DEBUG
+	cout << "entries " << entries[0] << " " << entries[1] << endl;
+#endif
+}
+
+inline void YaoGate::eval(YaoEvalWire& out, const Key* hashes,
+		const YaoEvalWire& left, const YaoEvalWire& right)
+{
+	Key key = hashes[0] ^ hashes[1];
+	if (left.external)
+		key ^= entries[0];
+	if (right.external)
+		key ^= entries[1] ^ left.key;
+	out.set(key);
+}
+#endif
 
 #endif /* YAO_YAOGATE_H_ */
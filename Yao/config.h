@@ -10,4 +10,7 @@
 
 //#define CHECK_BUFFER
 
+// two ciphertexts per AND gate (Zahur et al.) instead of four
+#define HALF_GATES
+
 #endif /* YAO_CONFIG_H_ */
@@ -63,6 +63,10 @@ def main():
                       help="bit length of sint in binary circuit (default: 0 for arithmetic)")
     parser.add_option("-F", "--field", dest="field", default=0,
                       help="bit length of sint modulo prime (default: 64)")
+    parser.add_option("-W", "--register-width", dest="register_width",
+                      default=0, help="bit length of secret registers in "
+                      "binary circuits (default: 128, use 256 or 512 with "
+                      "wide replicated registers)")
     options,args = parser.parse_args()
     if len(args) < 1:
         parser.print_help()
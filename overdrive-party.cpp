@@ -0,0 +1,116 @@
+/*
+ * overdrive-party.cpp
+ *
+ */
+
+#include "FHEOffline/SimpleMachine.h"
+#include "FHEOffline/PairwiseMachine.h"
+#include "Processor/StreamPrep.hpp"
+#include "Math/Setup.h"
+
+#include "Player-Online.hpp"
+
+/*
+ * Runs the offline phase of simple-offline.x or pairwise-offline.x
+ * alongside the SPDZ online phase. Every generator thread feeds the
+ * online thread of the same number, and the generators stop once the
+ * online phase has finished.
+ */
+class OverdriveCompanion : public OnlineCompanion<sgfp>
+{
+    bool pairwise;
+    int nthreads;
+    Dtype dtype;
+    MachineBase* machine;
+    vector<SpscRingBase*> streams;
+
+public:
+    OverdriveCompanion(bool pairwise, int nthreads, Dtype dtype) :
+            pairwise(pairwise), nthreads(nthreads), dtype(dtype), machine(0)
+    {
+    }
+
+    ~OverdriveCompanion()
+    {
+        if (machine)
+            delete machine;
+    }
+
+    void setup(Names& N, int lgp, int lg2, gfp& mac_key)
+    {
+        if (pairwise)
+            machine = new PairwiseMachine(N, nthreads, lgp);
+        else
+            machine = new SimpleMachine(N, nthreads, lgp, dtype);
+        machine->init_online_setup(lg2);
+        mac_key = machine->get_alphapi();
+        for (int i = 0; i < nthreads; i++)
+            streams.push_back(&StreamPrep<sgfp>::get_stream(i, dtype));
+    }
+
+    void start()
+    {
+        machine->start_streaming(streams);
+    }
+
+    void stop()
+    {
+        StreamPrep<sgfp>::close_streams();
+        machine->stop_streaming();
+        StreamPrep<sgfp>::delete_streams();
+    }
+};
+
+int main(int argc, const char** argv)
+{
+    ez::ezOptionParser opt;
+    opt.add(
+        "simple", // Default.
+        0, // Required?
+        1, // Number of args expected.
+        0, // Delimiter if expecting multiple args.
+        "Offline phase: simple (global proof, default) or pairwise (triples only)", // Help description.
+        "-G", // Flag token.
+        "--generator" // Flag token.
+    );
+    opt.add(
+        "1", // Default.
+        0, // Required?
+        1, // Number of args expected.
+        0, // Delimiter if expecting multiple args.
+        "Number of offline threads, one per online thread (default: 1)", // Help description.
+        "-x", // Flag token.
+        "--offline-threads" // Flag token.
+    );
+    opt.add(
+        "Triples", // Default.
+        0, // Required?
+        1, // Number of args expected.
+        0, // Delimiter if expecting multiple args.
+        "Data type to produce: Triples (default), Squares, Bits, or Inverses. "
+        "Everything else comes from the usual preprocessing.", // Help description.
+        "-T", // Flag token.
+        "--offline-type" // Flag token.
+    );
+    opt.parse(argc, argv);
+    string generator, type;
+    int nthreads;
+    opt.get("-G")->getString(generator);
+    opt.get("-x")->getInt(nthreads);
+    opt.get("-T")->getString(type);
+    opt.resetArgs();
+
+    int dtype = 0;
+    while (dtype < DATA_BITTRIPLE and type != DataPositions::dtype_names[dtype])
+        dtype++;
+    if (dtype == DATA_BITTRIPLE)
+        throw runtime_error("unknown data type: " + type);
+    if (generator != "simple" and generator != "pairwise")
+        throw runtime_error("unknown offline phase: " + generator);
+    if (generator == "pairwise" and dtype != DATA_TRIPLE)
+        throw runtime_error("pairwise offline phase only produces triples");
+
+    OverdriveCompanion companion(generator == "pairwise", nthreads,
+            Dtype(dtype));
+    return spdz_main<sgfp, Share<gf2n>>(argc, argv, opt, &companion);
+}